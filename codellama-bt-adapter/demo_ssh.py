@@ -25,25 +25,117 @@ def format_chat_prompt(messages):
 
 # demo_ssh.py
 import torch
-from transformers import AutoModelForCausalLM, AutoTokenizer
+from transformers import AutoModelForCausalLM, AutoTokenizer, LogitsProcessorList
 from peft import PeftModel
 import datetime
 import os
+import time
 import logging
 from pathlib import Path
-from retrieve_context import retrieve_similar_content
 from dotenv import load_dotenv
 import xml.dom.minidom
 import json
+import re
 
 logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
 logger = logging.getLogger(__name__)
 
-def initialize_model(base_model_path, lora_adapter_path):
+# Token limit per scenario. Constrained decoding closes the tree within the limit, so a limit below
+# the model's tree lengths yields valid but shortened trees; it stays at 512 until it is tuned
+# against them. Metadata records "budget_forced_close" when the limit cut a tree short.
+MAX_NEW_TOKENS = 512
+CONSTRAINED_MAX_NEW_TOKENS = 512
+
+# Characters of each retrieved chunk included in the prompt. Header node chunks put the node's
+# own doc comment and declaration first, so the cut drops instance data details, not the node.
+MAX_CONTEXT_CHARS_PER_CHUNK = 1500
+
+NODE_TYPES = {
+    "formationFiles": {
+        "AssembleFormationTask.h": "Manages the process of assembling units into specified formations",
+        "CreateFormationTask.h": "Handles creation and initialization of new unit formations",
+        "DeleteFormationTask.h": "Controls cleanup and removal of formations"
+    },
+    "movementFiles": {
+        "SelectNextRouteSegmentTask.h": "Controls progression through waypoints",
+        "NotifyRouteCompletedTask.h": "Handles route completion notifications",
+        "IssueBoundingOverwatchTask.h": "Coordinates bounding overwatch movement",
+        "IssueMovementOrdersTask.h": "Manages movement order distribution",
+        "IssueUnitMoveTacOrderTask.h": "Handles tactical movement orders"
+    },
+    "combatFiles": {
+        "IssueAttackOrdersTask.h": "Manages attack order distribution",
+        "IssueDefendPositionOrdersTask.h": "Handles defensive position orders",
+        "UnitAssignTargetsTask.h": "Controls target assignments",
+        "UnitCanEngageTargetCondition.h": "Evaluates engagement capabilities",
+        "UnitCombatPowerCondition.h": "Assesses relative combat strength"
+    },
+    "evaluatorFiles": {
+        "UnitEnemySituationEvaluator.h": "Assesses enemy situations",
+        "UnitHealthStateTreeEvaluator.h": "Monitors unit health status",
+        "UnitHierarchyEvaluator.h": "Manages unit organization"
+    },
+    "tacticalFiles": {
+        "IssueSubunitFindCoverTask.h": "Coordinates finding cover positions",
+        "IssueSubunitOccupyCoverTask.h": "Manages occupying cover positions",
+        "FindEngagementLocationTask.h": "Determines optimal engagement positions",
+        "CancelSubOrdersTask.h": "Manages order cancellation"
+    },
+    "perceptionFiles": {
+        "EntitySensedEntitiesComponent.h": "Manages individual entity sensory information",
+        "EntitySightModeComponent.h": "Controls entity vision and detection capabilities",
+        "EntityVisibilityComponent.h": "Handles entity visibility states and checks"
+    },
+    "entityMovementFiles": {
+        "EntityMovementComponent.h": "Controls individual entity movement",
+        "EntityPathfindingComponent.h": "Manages pathfinding for individual entities",
+        "EntityNavigationComponent.h": "Handles navigation and obstacle avoidance"
+    },
+    "entityCombatFiles": {
+        "EntityCombatComponent.h": "Manages individual combat capabilities",
+        "EntityWeaponComponent.h": "Controls weapon systems and firing",
+        "EntityTargetingComponent.h": "Handles target acquisition and tracking"
+    },
+    "healthFiles": {
+        "EntityHealthComponent.h": "Tracks entity health and damage",
+        "EntityStatusComponent.h": "Monitors entity status conditions",
+        "EntityVitalityComponent.h": "Manages stamina and other vital stats"
+    },
+    "behaviorFiles": {
+        "EntityBehaviorTreeComponent.h": "Controls individual AI decision making",
+        "EntityStateComponent.h": "Manages entity state machines",
+        "EntityTaskComponent.h": "Handles individual task execution"
+    },
+    "communicationFiles": {
+        "EntityMessageComponent.h": "Manages entity communication",
+        "EntitySignalComponent.h": "Handles signals and alerts",
+        "EntityCommandComponent.h": "Processes received commands"
+    }
+}
+
+def initialize_model(base_model_path, lora_adapter_path=None, merged_model_path=None):
+    """
+    Loads the base model and tokenizer and applies the LoRA adapter.
+
+    Args:
+        base_model_path (str): Base model path or Hugging Face id
+        lora_adapter_path (str): LoRA adapter path, or None to run the base model alone
+            (e.g. a tiny stand-in model on CPU)
+        merged_model_path (str): Checkpoint written by merge_adapter.py. When given, it is
+            loaded directly and base_model_path / lora_adapter_path are ignored
+
+    Returns:
+        tuple: (model, tokenizer)
+    """
     try:
         logger.info(f"CUDA available: {torch.cuda.is_available()}")
         if torch.cuda.is_available():
             logger.info(f"GPU Device: {torch.cuda.get_device_name(0)}")
+
+        if merged_model_path:
+            logger.info(f"Loading merged model from {merged_model_path}")
+            base_model_path = merged_model_path
+            lora_adapter_path = None
         
         tokenizer = AutoTokenizer.from_pretrained(base_model_path, trust_remote_code=True)
         tokenizer.pad_token = tokenizer.eos_token
@@ -55,11 +147,12 @@ def initialize_model(base_model_path, lora_adapter_path):
             trust_remote_code=True
         )
         
-        model = PeftModel.from_pretrained(
-            model,
-            lora_adapter_path,
-            torch_dtype=torch.float16 if torch.cuda.is_available() else torch.float32,
-        )
+        if lora_adapter_path:
+            model = PeftModel.from_pretrained(
+                model,
+                lora_adapter_path,
+                torch_dtype=torch.float16 if torch.cuda.is_available() else torch.float32,
+            )
         
         if torch.cuda.is_available():
             model.half()
@@ -102,95 +195,146 @@ def extract_xml_from_response(response):
         logger.error(f"Error extracting XML: {str(e)}")
         return response
 
-def generate_behavior_tree(model, tokenizer, prompt, scenario_name, output_dir, max_new_tokens=512, temperature=0.7, top_p=0.95):
+def retrieve_scenario_context(prompt, use_rag=True, top_k=3):
+    """
+    Retrieves doctrine context for a scenario prompt from the RAG index.
+
+    Args:
+        prompt (str): Scenario prompt
+        use_rag (bool): If False, no retrieval is done (e.g. offline CPU tests)
+        top_k (int): Number of chunks to retrieve
+
+    Returns:
+        tuple: (context text, number of chunks retrieved)
+    """
+    if not use_rag:
+        return "", 0
+
+    # Imported here so that the Pinecone connection is only opened when retrieval is used
+    from retrieve_context import retrieve_similar_content
+
+    results = retrieve_similar_content(prompt, "pdf-rag-index", top_k=top_k)
+    context = "\n\n".join([
+        match.metadata['text'][:MAX_CONTEXT_CHARS_PER_CHUNK]
+        for match in results.matches
+        if hasattr(match, 'metadata') and 'text' in match.metadata
+    ])
+    return context, len(results.matches)
+
+def build_prompt(prompt, context):
+    """
+    Formats the chat prompt for a scenario.
+
+    Args:
+        prompt (str): Scenario prompt
+        context (str): Retrieved doctrine context
+
+    Returns:
+        str: Prompt ready for tokenization
+    """
+    formatted_messages = [
+        {**msg, 'content': msg['content'].format(
+            node_types=json.dumps(NODE_TYPES),
+            context=context,
+            prompt=prompt
+        ) if msg['role'] == 'user' else msg['content']}
+        for msg in DEFAULT_MESSAGES
+    ]
+    return format_chat_prompt(formatted_messages)
+
+def build_prompt_prefix():
+    """
+    Returns the part of every prompt that precedes the retrieved context: the system
+    message and the node type catalogue. It is identical for all scenarios.
+
+    Returns:
+        str: Shared prompt prefix
+    """
+    marker = "\x00"
+    formatted_prompt = build_prompt(marker, marker)
+    return formatted_prompt[:formatted_prompt.index(marker)]
+
+def safe_scenario_name(scenario_name):
+    """Reduces a scenario name to characters that are safe in a file name."""
+    return re.sub(r'[^\w.-]', '_', scenario_name).lstrip('.') or "scenario"
+
+def save_behavior_tree(response, scenario_name, prompt, context, context_chunks, output_dir, generation_params, extra_metadata=None):
+    """
+    Extracts the XML from a model response and writes it with its metadata.
+
+    Args:
+        response (str): Decoded model output, without the prompt
+        scenario_name (str): Scenario name, used in file names after safe_scenario_name()
+        prompt (str): Scenario prompt
+        context (str): Retrieved doctrine context
+        context_chunks (int): Number of chunks retrieved
+        output_dir (str): Root of the xml/ and metadata/ directories
+        generation_params (dict): Generation settings recorded in the metadata
+        extra_metadata (dict): Additional metadata fields (e.g. timings)
+
+    Returns:
+        str: Path of the XML file
+    """
+    xml_content = extract_xml_from_response(response)
+
+    timestamp = datetime.datetime.now().strftime("%Y%m%d_%H%M%S")
+    file_stem = f"{safe_scenario_name(scenario_name)}_{timestamp}"
+    xml_filename = f"{file_stem}.xml"
+    xml_path = os.path.join(output_dir, "xml", xml_filename)
+    os.makedirs(os.path.dirname(xml_path), exist_ok=True)
+
+    with open(xml_path, 'w', encoding='utf-8') as f:
+        f.write(xml_content)
+
+    metadata = {
+        "timestamp": timestamp,
+        "scenario": scenario_name,
+        "prompt": prompt,
+        "context_chunks": context_chunks,
+        "context_used": context[:500] + "..." if len(context) > 500 else context,
+        "generation_params": generation_params
+    }
+    if extra_metadata:
+        metadata.update(extra_metadata)
+
+    metadata_path = os.path.join(output_dir, "metadata", f"{file_stem}.json")
+    os.makedirs(os.path.dirname(metadata_path), exist_ok=True)
+
+    with open(metadata_path, 'w', encoding='utf-8') as f:
+        json.dump(metadata, f, indent=2)
+
+    return xml_path
+
+def default_max_new_tokens(constrained):
+    """Returns the token limit per scenario with or without constrained decoding."""
+    return CONSTRAINED_MAX_NEW_TOKENS if constrained else MAX_NEW_TOKENS
+
+def generate_behavior_tree(model, tokenizer, prompt, scenario_name, output_dir, max_new_tokens=None, temperature=0.7, top_p=0.95, use_rag=True, prefix_cache=None, grammar_processor=None, speculative_kwargs=None):
+    if max_new_tokens is None:
+        max_new_tokens = default_max_new_tokens(grammar_processor is not None)
     try:
         logger.info(f"Generating behavior tree for scenario: {scenario_name}")
         
-        results = retrieve_similar_content(prompt, "pdf-rag-index", top_k=3)
-        context = "\n\n".join([
-            match.metadata['text']
-            for match in results.matches
-            if hasattr(match, 'metadata') and 'text' in match.metadata
-        ])
-        
-        node_types = json.stringify( {
-        "formationFiles": {
-          "AssembleFormationTask.h": "Manages the process of assembling units into specified formations",
-          "CreateFormationTask.h": "Handles creation and initialization of new unit formations",
-          "DeleteFormationTask.h": "Controls cleanup and removal of formations"
-        },
-        "movementFiles": {
-          "SelectNextRouteSegmentTask.h": "Controls progression through waypoints",
-          "NotifyRouteCompletedTask.h": "Handles route completion notifications",
-          "IssueBoundingOverwatchTask.h": "Coordinates bounding overwatch movement",
-          "IssueMovementOrdersTask.h": "Manages movement order distribution",
-          "IssueUnitMoveTacOrderTask.h": "Handles tactical movement orders"
-        },
-        "combatFiles": {
-          "IssueAttackOrdersTask.h": "Manages attack order distribution",
-          "IssueDefendPositionOrdersTask.h": "Handles defensive position orders",
-          "UnitAssignTargetsTask.h": "Controls target assignments",
-          "UnitCanEngageTargetCondition.h": "Evaluates engagement capabilities",
-          "UnitCombatPowerCondition.h": "Assesses relative combat strength"
-        },
-        "evaluatorFiles": {
-          "UnitEnemySituationEvaluator.h": "Assesses enemy situations",
-          "UnitHealthStateTreeEvaluator.h": "Monitors unit health status",
-          "UnitHierarchyEvaluator.h": "Manages unit organization"
-        },
-        "tacticalFiles": {
-          "IssueSubunitFindCoverTask.h": "Coordinates finding cover positions",
-          "IssueSubunitOccupyCoverTask.h": "Manages occupying cover positions",
-          "FindEngagementLocationTask.h": "Determines optimal engagement positions",
-          "CancelSubOrdersTask.h": "Manages order cancellation"
-        },
-        "perceptionFiles": {
-            "EntitySensedEntitiesComponent.h": "Manages individual entity sensory information",
-            "EntitySightModeComponent.h": "Controls entity vision and detection capabilities",
-            "EntityVisibilityComponent.h": "Handles entity visibility states and checks"
-        },
-        "movementFiles": {
-            "EntityMovementComponent.h": "Controls individual entity movement",
-            "EntityPathfindingComponent.h": "Manages pathfinding for individual entities",
-            "EntityNavigationComponent.h": "Handles navigation and obstacle avoidance"
-        },
-        "combatFiles": {
-            "EntityCombatComponent.h": "Manages individual combat capabilities",
-            "EntityWeaponComponent.h": "Controls weapon systems and firing",
-            "EntityTargetingComponent.h": "Handles target acquisition and tracking"
-        },
-        "healthFiles": {
-            "EntityHealthComponent.h": "Tracks entity health and damage",
-            "EntityStatusComponent.h": "Monitors entity status conditions",
-            "EntityVitalityComponent.h": "Manages stamina and other vital stats"
-        },
-        "behaviorFiles": {
-            "EntityBehaviorTreeComponent.h": "Controls individual AI decision making",
-            "EntityStateComponent.h": "Manages entity state machines",
-            "EntityTaskComponent.h": "Handles individual task execution"
-        },
-        "communicationFiles": {
-            "EntityMessageComponent.h": "Manages entity communication",
-            "EntitySignalComponent.h": "Handles signals and alerts",
-            "EntityCommandComponent.h": "Processes received commands"
-        }
-      })
-
-        formatted_messages = [
-            {**msg, 'content': msg['content'].format(
-                node_types=json.dumps(node_types),
-                context=context,
-                prompt=prompt
-            ) if msg['role'] == 'user' else msg['content']}
-            for msg in DEFAULT_MESSAGES
-        ]
-
-        formatted_prompt = format_chat_prompt(formatted_messages)        
+        context, context_chunks = retrieve_scenario_context(prompt, use_rag)
+        formatted_prompt = build_prompt(prompt, context)
         inputs = tokenizer(formatted_prompt, return_tensors="pt").to(model.device)
+
+        # Only the context and scenario text are prefilled when the shared prefix is cached
+        generation_kwargs = {}
+        if prefix_cache is not None:
+            past_key_values = prefix_cache.cache_for(inputs.input_ids)
+            if past_key_values is not None:
+                generation_kwargs["past_key_values"] = past_key_values
+        if grammar_processor is not None:
+            grammar_processor.prepare(max_new_tokens)
+            generation_kwargs["logits_processor"] = LogitsProcessorList([grammar_processor])
+        if speculative_kwargs:
+            generation_kwargs.update(speculative_kwargs)
         
         with torch.no_grad():
             outputs = model.generate(
                 **inputs,
+                **generation_kwargs,
                 max_new_tokens=max_new_tokens,
                 temperature=temperature,
                 top_p=top_p,
@@ -199,41 +343,219 @@ def generate_behavior_tree(model, tokenizer, prompt, scenario_name, output_dir,
         
         response = tokenizer.decode(outputs[0], skip_special_tokens=True)
         response = response[len(tokenizer.decode(inputs.input_ids[0], skip_special_tokens=True)):]
-        xml_content = extract_xml_from_response(response)
-        
-        timestamp = datetime.datetime.now().strftime("%Y%m%d_%H%M%S")
-        xml_filename = f"{scenario_name}_{timestamp}.xml"
-        xml_path = os.path.join(output_dir, "xml", xml_filename)
-        os.makedirs(os.path.dirname(xml_path), exist_ok=True)
-        
-        with open(xml_path, 'w', encoding='utf-8') as f:
-            f.write(xml_content)
-        
-        metadata = {
-            "timestamp": timestamp,
-            "scenario": scenario_name,
-            "prompt": prompt,
-            "context_chunks": len(results.matches),
-            "context_used": context[:500] + "..." if len(context) > 500 else context,
-            "generation_params": {
+
+        return save_behavior_tree(
+            response,
+            scenario_name,
+            prompt,
+            context,
+            context_chunks,
+            output_dir,
+            {
                 "max_new_tokens": max_new_tokens,
                 "temperature": temperature,
-                "top_p": top_p
+                "top_p": top_p,
+                "constrained_decoding": grammar_processor is not None,
+                "budget_forced_close": grammar_processor is not None and grammar_processor.was_budget_forced(),
+                "speculative_decoding": sorted(speculative_kwargs) if speculative_kwargs else None
             }
-        }
-        
-        metadata_path = os.path.join(output_dir, "metadata", f"{scenario_name}_{timestamp}.json")
-        os.makedirs(os.path.dirname(metadata_path), exist_ok=True)
-        
-        with open(metadata_path, 'w', encoding='utf-8') as f:
-            json.dump(metadata, f, indent=2)
-            
-        return xml_path
+        )
 
     except Exception as e:
         logger.error(f"Error generating behavior tree: {str(e)}")
         raise
 
+def generate_behavior_trees_batched(model, tokenizer, scenarios, output_dir, batch_size=8, max_new_tokens=None, temperature=0.7, top_p=0.95, use_rag=True, grammar_processor=None):
+    """
+    Generates behavior trees for several scenarios with one model.generate call per batch.
+
+    Prompts are sorted by token length before batching so that each batch pads as little
+    as possible, and left padded so that every row continues right after its prompt.
+
+    Args:
+        model: Loaded model
+        tokenizer: Tokenizer matching model
+        scenarios (list): Scenario dicts with "name" and "prompt"
+        output_dir (str): Root of the xml/ and metadata/ output directories
+        batch_size (int): Number of scenarios generated together
+        max_new_tokens (int): Token limit per scenario, or None for default_max_new_tokens()
+        temperature (float): Sampling temperature
+        top_p (float): Nucleus sampling threshold
+        use_rag (bool): Retrieve doctrine context for each scenario
+        grammar_processor (BehaviorTreeLogitsProcessor): Constrains the output to the
+            behavior tree grammar, or None for unconstrained generation
+
+    Returns:
+        list: Paths of the generated XML files, in the order of scenarios
+    """
+    if max_new_tokens is None:
+        max_new_tokens = default_max_new_tokens(grammar_processor is not None)
+    prepared = []
+    for scenario in scenarios:
+        context, context_chunks = retrieve_scenario_context(scenario["prompt"], use_rag)
+        formatted_prompt = build_prompt(scenario["prompt"], context)
+        prepared.append({
+            "scenario": scenario,
+            "context": context,
+            "context_chunks": context_chunks,
+            "formatted_prompt": formatted_prompt,
+            "length": len(tokenizer(formatted_prompt).input_ids)
+        })
+
+    order = sorted(range(len(prepared)), key=lambda i: prepared[i]["length"])
+    generated_files = [None] * len(prepared)
+
+    padding_side = tokenizer.padding_side
+    tokenizer.padding_side = "left"
+    try:
+        for start in range(0, len(order), batch_size):
+            batch = order[start:start + batch_size]
+            logger.info(f"Generating behavior trees for scenarios: {[prepared[i]['scenario']['name'] for i in batch]}")
+
+            inputs = tokenizer(
+                [prepared[i]["formatted_prompt"] for i in batch],
+                return_tensors="pt",
+                padding=True
+            ).to(model.device)
+
+            generation_kwargs = {}
+            if grammar_processor is not None:
+                grammar_processor.prepare(max_new_tokens)
+                generation_kwargs["logits_processor"] = LogitsProcessorList([grammar_processor])
+
+            with torch.no_grad():
+                outputs = model.generate(
+                    **inputs,
+                    **generation_kwargs,
+                    max_new_tokens=max_new_tokens,
+                    temperature=temperature,
+                    top_p=top_p,
+                    pad_token_id=tokenizer.eos_token_id
+                )
+
+            prompt_length = inputs.input_ids.shape[-1]
+            for row, index in enumerate(batch):
+                item = prepared[index]
+                response = tokenizer.decode(outputs[row][prompt_length:], skip_special_tokens=True)
+                generated_files[index] = save_behavior_tree(
+                    response,
+                    item["scenario"]["name"],
+                    item["scenario"]["prompt"],
+                    item["context"],
+                    item["context_chunks"],
+                    output_dir,
+                    {
+                        "max_new_tokens": max_new_tokens,
+                        "temperature": temperature,
+                        "top_p": top_p,
+                        "batch_size": len(batch),
+                        "constrained_decoding": grammar_processor is not None,
+                        "budget_forced_close": grammar_processor is not None and grammar_processor.was_budget_forced(row)
+                    }
+                )
+    except Exception as e:
+        logger.error(f"Error generating behavior trees: {str(e)}")
+        raise
+    finally:
+        tokenizer.padding_side = padding_side
+
+    return generated_files
+
+def log_benchmark(message):
+    """Appends a line to BENCHMARK_LOG when it is set."""
+    benchmark_log = os.getenv('BENCHMARK_LOG')
+    if benchmark_log:
+        with open(benchmark_log, 'a', encoding='utf-8') as f:
+            f.write(message + '\n')
+
+def load_scenarios(scenarios_file):
+    """
+    Reads a scenarios file of the form {"scenarios": [{"name": ..., "prompt": ...}]}.
+
+    Args:
+        scenarios_file (str): Path to the scenarios JSON file
+
+    Returns:
+        list: Scenario dicts
+    """
+    with open(scenarios_file, 'r', encoding='utf-8') as f:
+        return json.load(f)["scenarios"]
+
+def process_scenarios(scenarios_file, output_dir, model=None, tokenizer=None, batch_size=None, use_prefix_cache=True, use_grammar=True, speculative_mode=None):
+    """
+    Generates a behavior tree for every scenario of a scenarios file.
+
+    Args:
+        scenarios_file (str): Path to the scenarios JSON file
+        output_dir (str): Root of the xml/ and metadata/ output directories
+        model: Loaded model, or None to load it from MERGED_MODEL_PATH, or else
+            BASE_MODEL_PATH / LORA_ADAPTER_PATH
+        tokenizer: Tokenizer matching model
+        batch_size (int): Scenarios generated together, or None to read GENERATION_BATCH_SIZE
+            (default 1, one scenario at a time)
+        use_prefix_cache (bool): Reuse the KV cache of the shared prompt prefix across
+            scenarios when generating one scenario at a time
+        use_grammar (bool): Constrain generation to the behavior tree XML grammar
+        speculative_mode (str): "prompt_lookup" or "draft" (draft model from DRAFT_MODEL_PATH)
+            for speculative decoding when generating one scenario at a time, or None to
+            read SPECULATIVE_MODE
+
+    Returns:
+        list: Paths of the generated XML files
+    """
+    if batch_size is None:
+        batch_size = int(os.getenv('GENERATION_BATCH_SIZE', '1'))
+    if speculative_mode is None:
+        speculative_mode = os.getenv('SPECULATIVE_MODE')
+
+    if model is None:
+        load_dotenv()
+        model, tokenizer = initialize_model(
+            os.getenv('BASE_MODEL_PATH'),
+            os.getenv('LORA_ADAPTER_PATH'),
+            os.getenv('MERGED_MODEL_PATH')
+        )
+
+    grammar_processor = None
+    if use_grammar:
+        from xml_grammar import BehaviorTreeGrammar, BehaviorTreeLogitsProcessor
+        grammar_processor = BehaviorTreeLogitsProcessor(BehaviorTreeGrammar(), tokenizer)
+
+    scenarios = load_scenarios(scenarios_file)
+    start = time.time()
+    if batch_size > 1:
+        generated_files = generate_behavior_trees_batched(
+            model, tokenizer, scenarios, output_dir, batch_size, grammar_processor=grammar_processor
+        )
+    else:
+        generation_kwargs = {}
+        if speculative_mode:
+            from speculative import load_draft_model, speculative_kwargs
+            draft_model = load_draft_model(os.getenv('DRAFT_MODEL_PATH')) if speculative_mode == "draft" else None
+            generation_kwargs = speculative_kwargs(speculative_mode, draft_model)
+            # Assisted generation manages its own cache, so the whole prompt is prefilled
+            use_prefix_cache = False
+
+        prefix_cache = None
+        if use_prefix_cache:
+            from prefix_cache import PromptPrefixCache
+            prefix_cache = PromptPrefixCache(model, tokenizer)
+
+        generated_files = []
+        for scenario in scenarios:
+            generated_files.append(generate_behavior_tree(
+                model, tokenizer, scenario["prompt"], scenario["name"], output_dir,
+                prefix_cache=prefix_cache, grammar_processor=grammar_processor,
+                speculative_kwargs=generation_kwargs
+            ))
+    elapsed = time.time() - start
+
+    log_benchmark(
+        f"process_scenarios: {len(generated_files)} trees in {elapsed:.2f}s "
+        f"({len(generated_files) / elapsed * 60 if elapsed > 0 else 0:.2f} trees/min, batch size {batch_size})"
+    )
+    return generated_files
+
 if __name__ == "__main__":
     import sys
     
@@ -0,0 +1,142 @@
+# embedding_service.py
+"""
+Shared sentence embedding service.
+
+Holds one SentenceTransformer instance per model name for the whole process, encodes texts
+in batches, and caches embeddings by content hash in memory (LRU) and on disk, so chunks
+of headers and PDFs that did not change are never encoded again.
+
+The disk cache lives in EMBEDDING_CACHE_DIR (embedding_cache/ next to this file by default),
+one .npy file per text under <model name>/<first two hash characters>/. Only ingested chunks
+are written there; query embeddings are cached in memory only, so retrieval does not grow
+the disk cache.
+"""
+import hashlib
+import logging
+import os
+from collections import OrderedDict
+
+import numpy as np
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+DEFAULT_MODEL = 'all-MiniLM-L6-v2'
+CACHE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "embedding_cache")
+
+# Loaded models, by name
+models = {}
+
+def get_model(model_name=DEFAULT_MODEL):
+    """Returns the shared SentenceTransformer for a model name, loading it on first use."""
+    if model_name not in models:
+        from sentence_transformers import SentenceTransformer
+        logger.info(f"Loading embedding model {model_name}")
+        models[model_name] = SentenceTransformer(model_name)
+    return models[model_name]
+
+def content_hash(text, model_name=DEFAULT_MODEL):
+    """Returns the cache key of a text: SHA-256 of the model name and the text."""
+    return hashlib.sha256(f"{model_name}\0{text}".encode('utf-8')).hexdigest()
+
+class EmbeddingCache:
+    """
+    Embedding cache keyed by content hash: an in-memory LRU in front of a disk cache.
+
+    Args:
+        cache_dir (str): Disk cache directory, or None for memory only
+        max_entries (int): Maximum number of embeddings kept in memory
+    """
+
+    def __init__(self, cache_dir=None, max_entries=10000):
+        self.cache_dir = cache_dir
+        self.max_entries = max_entries
+        self.entries = OrderedDict()
+        self.hits = 0
+        self.misses = 0
+
+    def path(self, key, model_name):
+        return os.path.join(self.cache_dir, model_name.replace('/', '_'), key[:2], f"{key}.npy")
+
+    def get(self, key, model_name):
+        """Returns a cached embedding, or None."""
+        embedding = self.entries.get(key)
+        if embedding is not None:
+            self.entries.move_to_end(key)
+            self.hits += 1
+            return embedding
+
+        if self.cache_dir:
+            path = self.path(key, model_name)
+            if os.path.exists(path):
+                embedding = np.load(path)
+                self.remember(key, embedding)
+                self.hits += 1
+                return embedding
+
+        self.misses += 1
+        return None
+
+    def put(self, key, model_name, embedding, persist=True):
+        """Stores an embedding in memory, and on disk when persist is set."""
+        self.remember(key, embedding)
+        if self.cache_dir and persist:
+            path = self.path(key, model_name)
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            # Write then rename, so concurrent readers never load a partial file
+            temporary_path = f"{path}.{os.getpid()}.tmp"
+            with open(temporary_path, 'wb') as f:
+                np.save(f, embedding)
+            os.replace(temporary_path, path)
+
+    def remember(self, key, embedding):
+        self.entries[key] = embedding
+        self.entries.move_to_end(key)
+        while len(self.entries) > self.max_entries:
+            self.entries.popitem(last=False)
+
+    def get_stats(self):
+        """Returns the hit and miss counters."""
+        return {"hits": self.hits, "misses": self.misses, "in_memory": len(self.entries)}
+
+cache = EmbeddingCache(os.getenv('EMBEDDING_CACHE_DIR', CACHE_DIR))
+
+def embed_texts(texts, model_name=DEFAULT_MODEL, batch_size=64, persist=True):
+    """
+    Embeds texts, encoding only those missing from the cache, in one batched call.
+
+    Args:
+        texts (list): Texts to embed
+        model_name (str): SentenceTransformer model name
+        batch_size (int): Encoding batch size
+        persist (bool): Write new embeddings to the disk cache, not only to memory
+
+    Returns:
+        np.ndarray: Embeddings (len(texts), dim), in the order of texts; an empty (0, 0)
+            array for no texts, without loading the model
+    """
+    if not texts:
+        return np.zeros((0, 0), dtype=np.float32)
+
+    keys = [content_hash(text, model_name) for text in texts]
+    embeddings = [cache.get(key, model_name) for key in keys]
+
+    # Identical texts are encoded once
+    missing = {}
+    for position, embedding in enumerate(embeddings):
+        if embedding is None:
+            missing.setdefault(keys[position], texts[position])
+
+    if missing:
+        encoded = get_model(model_name).encode(list(missing.values()), batch_size=batch_size)
+        encoded = {key: np.asarray(embedding, dtype=np.float32) for key, embedding in zip(missing, encoded)}
+        for key, embedding in encoded.items():
+            cache.put(key, model_name, embedding, persist)
+        embeddings = [embedding if embedding is not None else encoded[key] for key, embedding in zip(keys, embeddings)]
+        logger.info(f"Encoded {len(missing)} new texts for {len(texts)} requested, the rest came from the cache")
+
+    return np.stack(embeddings)
+
+def embed_query(text, model_name=DEFAULT_MODEL):
+    """Embeds a single query text, as a list for index.query. Cached in memory only."""
+    return embed_texts([text], model_name, persist=False)[0].tolist()
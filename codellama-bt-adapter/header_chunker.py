@@ -0,0 +1,381 @@
+# header_chunker.py
+"""
+Structure-aware chunking of the MilVerse state tree headers for ingestion.
+
+Fixed-size windows split USTRUCT declarations and UPROPERTY blocks mid-token. This module
+parses the top-level struct and class declarations of a header instead and emits one chunk
+per state tree node type, holding the node's own doc comments and declaration followed by its
+instance data struct (or event payload struct). Each chunk carries metadata for retrieval:
+
+    node      struct or class name, e.g. "FChangeStanceTask"
+    kind      "Task", "Condition", "Evaluator" or "Event"
+    level     "MilVerseEntityLevel", "MilVerseUnitLevel", "MilVerseGenericLevel", or "" for events
+    handles   component types of the TStateTreeExternalDataHandle members
+    source    header file name
+
+The whole chunk is too long for the embedding model, which truncates its input at 256
+wordpieces, so node chunks also carry an "embed_text" that fits: the summary line, the node's
+doc comment and the field names of its instance data. upsert_document.py embeds "embed_text"
+and stores the full "text" as the context returned by retrieval.
+
+Enums used by a node (e.g. the stage enum of its instance data) are appended to the node's
+chunk. Every other declaration of the header (enums, helper structs and classes) is split
+into windows of whole lines with a "declaration" metadata key, as are headers declaring no
+node type at all (subsystems, components, helpers).
+
+Usage:
+    python3 header_chunker.py                  # compares chunk counts with fixed windows
+    python3 header_chunker.py FILE.h [...]     # prints the chunks of the given headers
+"""
+import json
+import logging
+import os
+import re
+import sys
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+HEADER_DIRS = [
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "header_files", "EntityAI"),
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "header_files", "UnitAI"),
+]
+
+# Node kind of each state tree node base class
+NODE_BASES = {
+    "FMilVerseStateTreeTask": "Task",
+    "FMilVersePersistentStateTreeTask": "Task",
+    "FMilVerseStateTreeCondition": "Condition",
+    "FMilVerseStateTreeEvaluator": "Evaluator",
+    "MilVerseStateTreeEvent": "Event",
+}
+
+LEVELS = ["MilVerseEntityLevel", "MilVerseUnitLevel", "MilVerseGenericLevel"]
+
+# Start of a top-level declaration: struct/class/enum name and first base class (underlying
+# type for enums)
+DECLARATION_PATTERN = re.compile(
+    r"^(struct|class|enum\s+class|enum)\s+(?:\w+_API\s+)?(\w+)\s*(?:final\s*)?(?::\s*(?:public\s+)?(\w+))?[^;{]*\{",
+    re.MULTILINE
+)
+USTRUCT_PATTERN = re.compile(r"USTRUCT\(([^\n]*)\)\s*$")
+INSTANCE_DATA_PATTERN = re.compile(r"using\s+FInstanceDataType\s*=\s*(\w+)\s*;")
+HANDLE_PATTERN = re.compile(r"TStateTreeExternalDataHandle<\s*(\w+)")
+# Data member of a struct: "Type Name;" or "Type Name = Default;"
+FIELD_PATTERN = re.compile(
+    r"^\s*(?!using\b|return\b|friend\b|static\b|virtual\b|typedef\b)[\w:<>,*&\s]+?[\s*&](\w+)\s*(?:=[^;]*)?;\s*$",
+    re.MULTILINE
+)
+
+# Characters of "embed_text". all-MiniLM-L6-v2 truncates at 256 wordpieces, which is about
+# 800 characters of doc comments and C++ identifiers.
+EMBED_TEXT_MAX_CHARS = 800
+
+class Declaration:
+    """A top-level struct, class or enum declaration with its doc comments and U* macro."""
+
+    def __init__(self, name, base, meta, text, is_enum=False):
+        self.name = name
+        self.base = base
+        self.meta = meta
+        self.text = text
+        self.is_enum = is_enum
+
+def find_block_end(text, open_brace):
+    """Returns the index just past the '};' closing the block opened at open_brace."""
+    depth = 0
+    position = open_brace
+    while position < len(text):
+        char = text[position]
+        if char == '{':
+            depth += 1
+        elif char == '}':
+            depth -= 1
+            if depth == 0:
+                semicolon = text.find(';', position)
+                return len(text) if semicolon == -1 else semicolon + 1
+        elif text.startswith('//', position):
+            newline = text.find('\n', position)
+            position = len(text) if newline == -1 else newline
+            continue
+        position += 1
+    return len(text)
+
+def leading_block_start(text, start):
+    """
+    Returns the start of the USTRUCT/UCLASS/UENUM macro and /// doc comment lines directly
+    above a declaration starting at start.
+    """
+    lines = text[:start].split('\n')
+    # The last element is the (empty) part of the declaration line before "struct"
+    lines.pop()
+    begin = start
+    while lines:
+        line = lines[-1].strip()
+        if not (line.startswith('///') or line.startswith(('USTRUCT(', 'UCLASS(', 'UENUM('))):
+            break
+        begin -= len(lines.pop()) + 1
+    return begin
+
+def parse_declarations(text):
+    """
+    Parses the top-level struct, class and enum declarations of a header.
+
+    Args:
+        text (str): Header source
+
+    Returns:
+        list: Declarations, in source order
+    """
+    declarations = []
+    position = 0
+    while True:
+        match = DECLARATION_PATTERN.search(text, position)
+        if not match:
+            break
+        begin = leading_block_start(text, match.start())
+        end = find_block_end(text, match.end() - 1)
+        preamble = text[begin:match.start()]
+        ustruct = None
+        for line in preamble.split('\n'):
+            ustruct = USTRUCT_PATTERN.search(line.strip()) or ustruct
+        is_enum = match.group(1).startswith("enum")
+        declarations.append(Declaration(
+            match.group(2),
+            None if is_enum else match.group(3),
+            ustruct.group(1) if ustruct else "",
+            text[begin:end].strip(),
+            is_enum
+        ))
+        position = end
+    return declarations
+
+def collect_bases(texts):
+    """Returns struct/class name -> first base class over several header sources."""
+    bases = {}
+    for text in texts:
+        for declaration in parse_declarations(text):
+            if declaration.base:
+                bases[declaration.name] = declaration.base
+    return bases
+
+def node_kind(name, bases):
+    """
+    Returns the node kind of a struct, following derived node structs (e.g.
+    FAviationMoveTask : FMoveTask) to their state tree base, or None.
+    """
+    seen = set()
+    while name and name not in seen:
+        seen.add(name)
+        base = bases.get(name)
+        if base in NODE_BASES:
+            return NODE_BASES[base]
+        name = base
+    return None
+
+def node_level(meta):
+    """Returns the MilVerse level named in a USTRUCT meta specifier, or ""."""
+    for level in LEVELS:
+        if level in meta:
+            return level
+    return ""
+
+def chunk_lines(text, chunk_size=500):
+    """Packs whole lines into chunks of about chunk_size characters."""
+    chunks = []
+    current = ""
+    for line in text.split('\n'):
+        if current and len(current) + len(line) + 1 > chunk_size:
+            chunks.append(current)
+            current = ""
+        current = f"{current}\n{line}" if current else line
+    if current.strip():
+        chunks.append(current)
+    return chunks
+
+def doc_comment(declaration_text):
+    """Returns the /// doc comment above a declaration as one line, without Doxygen groups."""
+    lines = []
+    for line in declaration_text.split('\n'):
+        line = line.strip()
+        if not line.startswith('///'):
+            if lines:
+                break
+            continue
+        line = line[3:].strip()
+        if line and not line.startswith('@ingroup'):
+            lines.append(line.replace('@brief ', ''))
+    return ' '.join(lines)
+
+def field_names(struct_text):
+    """Returns the names of the data members of a struct declaration, in order."""
+    body = struct_text[struct_text.find('{') + 1:]
+    return FIELD_PATTERN.findall(body)
+
+def node_embed_text(summary, declaration, companion):
+    """
+    Returns the text embedded for a node chunk: the summary, the node's doc comment and the
+    field names of its instance data, capped at EMBED_TEXT_MAX_CHARS.
+    """
+    parts = [summary, doc_comment(declaration.text)]
+    if companion is not None:
+        fields = field_names(companion.text)
+        if fields:
+            parts.append(f"{companion.name} fields: {', '.join(fields)}")
+    return '\n'.join(part for part in parts if part)[:EMBED_TEXT_MAX_CHARS]
+
+def mentions(text, name):
+    """Returns True if text uses the identifier name."""
+    return re.search(rf"\b{re.escape(name)}\b", text) is not None
+
+def chunk_header(text, source, bases=None):
+    """
+    Splits a header into one chunk per state tree node type, followed by line windows of
+    the declarations no node chunk holds.
+
+    Args:
+        text (str): Header source
+        source (str): Header file name, stored in the metadata
+        bases (dict): Name -> base class over all headers ingested together, so derived
+            node structs declared in other files are recognized; this header's own by default
+
+    Returns:
+        list: Chunk metadata dicts with "text", "embed_text", "node", "kind", "level", "handles"
+            and "source" for nodes, and "text", "declaration" and "source" for other
+            declarations
+    """
+    declarations = parse_declarations(text)
+    if bases is None:
+        bases = collect_bases([text])
+    by_name = {declaration.name: declaration for declaration in declarations}
+    enums = [declaration for declaration in declarations if declaration.is_enum]
+
+    chunks = []
+    used = set()
+    for declaration in declarations:
+        kind = node_kind(declaration.name, bases)
+        if kind is None:
+            continue
+
+        # Instance data of tasks/conditions/evaluators, payload of events
+        if kind == "Event":
+            companion = by_name.get(f"F{declaration.name}Payload")
+        else:
+            alias = INSTANCE_DATA_PATTERN.search(declaration.text)
+            companion = by_name.get(alias.group(1) if alias else f"{declaration.name}InstanceData")
+
+        level = node_level(declaration.meta)
+        handles = sorted(set(HANDLE_PATTERN.findall(declaration.text)))
+        summary = f"// {kind} {declaration.name}"
+        if level:
+            summary += f" ({level})"
+        if handles:
+            summary += f", external data: {', '.join(handles)}"
+        # The node's own doc comment and declaration come first, so a reader (or a prompt
+        # budget) that stops early still sees what the node does
+        parts = [summary, declaration.text]
+        used.add(declaration.name)
+        if companion is not None:
+            parts.append(companion.text)
+            used.add(companion.name)
+
+        # Enums the node or its instance data refer to, e.g. their stage enum
+        for enum in enums:
+            if any(mentions(part, enum.name) for part in parts[1:]):
+                parts.append(enum.text)
+                used.add(enum.name)
+
+        chunks.append({
+            "text": "\n\n".join(parts),
+            "embed_text": node_embed_text(summary, declaration, companion),
+            "node": declaration.name,
+            "kind": kind,
+            "level": level,
+            "handles": handles,
+            "source": source,
+        })
+
+    if not chunks:
+        return [{"text": chunk, "source": source} for chunk in chunk_lines(text)]
+
+    # Everything else the header declares: unreferenced enums, helper structs and classes
+    for declaration in declarations:
+        if declaration.name not in used:
+            chunks.extend(
+                {"text": chunk, "declaration": declaration.name, "source": source}
+                for chunk in chunk_lines(declaration.text)
+            )
+    return chunks
+
+def is_header(filename):
+    """Returns True for C++ headers, skipping macOS "._" resource fork files."""
+    return filename.endswith(".h") and not filename.startswith("._")
+
+def chunk_headers(header_paths):
+    """
+    Chunks several headers, resolving derived node structs across all of them.
+
+    Args:
+        header_paths (list): Header file paths
+
+    Returns:
+        list: (header path, chunks) tuples
+    """
+    texts = []
+    for header_path in header_paths:
+        with open(header_path, 'r', encoding='utf-8', errors='ignore') as f:
+            texts.append(f.read())
+    bases = collect_bases(texts)
+    return [
+        (header_path, chunk_header(text, os.path.basename(header_path), bases))
+        for header_path, text in zip(header_paths, texts)
+    ]
+
+def compare_with_fixed_windows(header_dirs=None, chunk_size=500):
+    """
+    Compares the chunks produced for the header directories with fixed-size windows.
+
+    Args:
+        header_dirs (list): Directories to chunk, header_files/EntityAI and UnitAI by default
+        chunk_size (int): Window size of the fixed-size chunker
+
+    Returns:
+        dict: Chunk counts and node chunks per kind
+    """
+    header_paths = [
+        os.path.join(header_dir, filename)
+        for header_dir in header_dirs or HEADER_DIRS
+        for filename in sorted(os.listdir(header_dir))
+        if is_header(filename)
+    ]
+    chunked = chunk_headers(header_paths)
+
+    fixed = 0
+    for header_path in header_paths:
+        with open(header_path, 'r', encoding='utf-8', errors='ignore') as f:
+            fixed += -(-len(f.read()) // chunk_size)
+
+    kinds = {}
+    for _, chunks in chunked:
+        for chunk in chunks:
+            kind = chunk.get("kind", "Other")
+            kinds[kind] = kinds.get(kind, 0) + 1
+
+    results = {
+        "headers": len(header_paths),
+        "fixed_window_chunks": fixed,
+        "structured_chunks": sum(len(chunks) for _, chunks in chunked),
+        "chunks_per_kind": kinds,
+    }
+    logger.info(json.dumps(results, indent=2))
+    return results
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        for header_path, chunks in chunk_headers(sys.argv[1:]):
+            for chunk in chunks:
+                print(json.dumps({k: v for k, v in chunk.items() if k != "text"}))
+                print(chunk["text"])
+                print()
+    else:
+        compare_with_fixed_windows()
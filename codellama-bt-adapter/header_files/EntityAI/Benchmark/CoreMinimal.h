@@ -0,0 +1,129 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Minimal stand-ins for the Unreal Engine types used by
+//--| TargetScoringKernel.h, so the kernel can be benchmarked off-tree.
+//--| Only what the kernel touches is provided; not for use in the module.
+//--|
+//--|====================================================================|--
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using int32 = std::int32_t;
+using uint32 = std::uint32_t;
+
+#define INDEX_NONE (-1)
+#define UE_BIG_NUMBER (3.4e+38f)
+#define RESTRICT __restrict
+#define SIMULATIONBEHAVIORS_API
+#define USTRUCT(...)
+#define UPROPERTY(...)
+#define GENERATED_BODY()
+
+struct FGuid
+{
+    uint32 A = 0;
+    uint32 B = 0;
+    uint32 C = 0;
+    uint32 D = 0;
+};
+
+struct FVector
+{
+    double X = 0.0;
+    double Y = 0.0;
+    double Z = 0.0;
+
+    static const FVector ForwardVector;
+};
+
+inline const FVector FVector::ForwardVector = {1.0, 0.0, 0.0};
+
+struct FMath
+{
+    static float Sqrt(const float Value)
+    {
+        return std::sqrt(Value);
+    }
+};
+
+/// @brief The subset of `TArray` used by the kernel, backed by `std::vector`.
+template <typename T>
+class TArray
+{
+public:
+    void Reset()
+    {
+        Items.clear();
+    }
+
+    int32 Add(const T& Item)
+    {
+        Items.push_back(Item);
+        return Num() - 1;
+    }
+
+    void Insert(const T& Item, const int32 Index)
+    {
+        Items.insert(Items.begin() + Index, Item);
+    }
+
+    T Pop(bool /*bAllowShrinking*/ = true)
+    {
+        T Item = Items.back();
+        Items.pop_back();
+        return Item;
+    }
+
+    void SetNumUninitialized(const int32 Count)
+    {
+        Items.resize(Count);
+    }
+
+    int32 Num() const
+    {
+        return static_cast<int32>(Items.size());
+    }
+
+    T* GetData()
+    {
+        return Items.data();
+    }
+
+    const T* GetData() const
+    {
+        return Items.data();
+    }
+
+    const T& Last() const
+    {
+        return Items.back();
+    }
+
+    T& operator[](const int32 Index)
+    {
+        return Items[Index];
+    }
+
+    const T& operator[](const int32 Index) const
+    {
+        return Items[Index];
+    }
+
+private:
+    std::vector<T> Items;
+};
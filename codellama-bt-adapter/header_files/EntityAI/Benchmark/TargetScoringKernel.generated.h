@@ -0,0 +1,2 @@
+//--| Empty stand-in for the header generated by UnrealHeaderTool. See CoreMinimal.h.
+#pragma once
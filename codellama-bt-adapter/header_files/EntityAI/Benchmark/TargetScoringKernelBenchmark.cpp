@@ -0,0 +1,203 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Off-tree benchmark of FTargetScoringKernel against a per-candidate
+//--| scalar loop, for 10, 100 and 1000 candidates.
+//--|
+//--| Built without Unreal Engine against the stand-ins in CoreMinimal.h:
+//--|
+//--|   g++ -std=c++17 -O3 -march=x86-64-v3 -fno-trapping-math -fno-math-errno
+//--|       -I . -I ../.. TargetScoringKernelBenchmark.cpp -o target_scoring_benchmark
+//--|   ./target_scoring_benchmark [runs]
+//--|
+//--| Without both -fno-trapping-math and -fno-math-errno, GCC keeps the
+//--| scoring loop scalar (-fopt-info-vec shows which loops were vectorized).
+//--| Times are the best of [runs] batches, per selection, score plus select;
+//--| packing the candidates is not included. The result is appended to
+//--| BENCHMARK_LOG when it is set.
+//--|
+//--|====================================================================|--
+
+// MilVerse
+#include "EntityAI/TargetScoringKernel.h"
+
+// Standard library
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+/// @brief A candidate as the target selection tasks held it before the kernel.
+struct FScalarCandidate
+{
+    FGuid Id;
+    FVector Position;
+    float Priority = 0.f;
+    bool bIsAssigned = false;
+};
+
+/// @brief The per-candidate loop the kernel replaced: score each candidate from its struct and
+/// keep the best one as it goes.
+int32 SelectBestScalar(const std::vector<FScalarCandidate>& Candidates,
+    const FVector& Origin,
+    const FTargetScoringWeights& Weights,
+    const FVector& SectorDirection,
+    const float SectorHalfAngleCos)
+{
+    int32 BestIndex = INDEX_NONE;
+    float BestScore = FTargetScoringKernel::RejectedScore;
+    for (int32 Index = 0; Index < static_cast<int32>(Candidates.size()); ++Index)
+    {
+        const FScalarCandidate& Candidate = Candidates[Index];
+        const FVector Offset = {Candidate.Position.X - Origin.X,
+            Candidate.Position.Y - Origin.Y,
+            Candidate.Position.Z - Origin.Z};
+        const float Distance = static_cast<float>(
+            std::sqrt(Offset.X * Offset.X + Offset.Y * Offset.Y + Offset.Z * Offset.Z));
+        if (Weights.bRequireInSector)
+        {
+            const double Dot = Offset.X * SectorDirection.X + Offset.Y * SectorDirection.Y
+                + Offset.Z * SectorDirection.Z;
+            if (Dot < SectorHalfAngleCos * Distance)
+            {
+                continue;
+            }
+        }
+        float Score = Weights.PriorityWeight * Candidate.Priority
+            - Weights.DistanceWeight * 0.01f * Distance;
+        if (Candidate.bIsAssigned)
+        {
+            Score += Weights.AssignedBonus;
+        }
+        if (Score > BestScore)
+        {
+            BestScore = Score;
+            BestIndex = Index;
+        }
+    }
+    return BestIndex;
+}
+
+/// @brief Returns the time of one call of `Select` in nanoseconds: the fastest mean among `Runs`
+/// batches of `Repeats` calls.
+template <typename SelectType>
+double MeasureNanoseconds(SelectType&& Select, const int32 Runs, const int32 Repeats)
+{
+    double Best = 1e300;
+    for (int32 Run = 0; Run < Runs; ++Run)
+    {
+        const auto Start = std::chrono::steady_clock::now();
+        for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            Select();
+        }
+        const auto End = std::chrono::steady_clock::now();
+        const double Elapsed = std::chrono::duration<double, std::nano>(End - Start).count();
+        Best = std::min(Best, Elapsed / Repeats);
+    }
+    return Best;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int32 Runs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+    FTargetScoringWeights Weights;
+    Weights.PriorityWeight = 1.f;
+    Weights.DistanceWeight = 0.002f;
+    Weights.AssignedBonus = 0.5f;
+    Weights.bRequireInSector = true;
+    const FVector Origin = {0.0, 0.0, 0.0};
+    const FVector SectorDirection = FVector::ForwardVector;
+    const float SectorHalfAngleCos = 0.5f;
+
+    std::FILE* Log = nullptr;
+    if (const char* LogPath = std::getenv("BENCHMARK_LOG"))
+    {
+        Log = std::fopen(LogPath, "a");
+    }
+
+    std::mt19937 Random(0);
+    std::uniform_real_distribution<float> Coordinate(-300000.f, 300000.f);
+    std::uniform_real_distribution<float> Priority(0.f, 10.f);
+
+    bool bAllMatched = true;
+    for (const int32 NumCandidates : {10, 100, 1000})
+    {
+        std::vector<FScalarCandidate> Candidates(NumCandidates);
+        FTargetScoringKernel Kernel;
+        for (int32 Index = 0; Index < NumCandidates; ++Index)
+        {
+            FScalarCandidate& Candidate = Candidates[Index];
+            Candidate.Id.A = static_cast<uint32>(Index);
+            Candidate.Position = {
+                Coordinate(Random), Coordinate(Random), Coordinate(Random) * 0.01f};
+            Candidate.Priority = Priority(Random);
+            Candidate.bIsAssigned = Index == NumCandidates / 2;
+            Kernel.AddCandidate(
+                Candidate.Id, Candidate.Position, Candidate.Priority, Candidate.bIsAssigned);
+        }
+
+        const int32 Repeats = std::max(1000, 2000000 / NumCandidates);
+        volatile int32 Sink = 0;
+        const double KernelNs = MeasureNanoseconds(
+            [&]()
+            {
+                Kernel.Score(Origin, Weights, SectorDirection, SectorHalfAngleCos);
+                Sink = Kernel.SelectBest();
+            },
+            Runs,
+            Repeats);
+        const double ScalarNs = MeasureNanoseconds(
+            [&]()
+            {
+                Sink = SelectBestScalar(
+                    Candidates, Origin, Weights, SectorDirection, SectorHalfAngleCos);
+            },
+            Runs,
+            Repeats);
+        (void)Sink;
+
+        const int32 KernelBest = Kernel.SelectBest();
+        const int32 ScalarBest =
+            SelectBestScalar(Candidates, Origin, Weights, SectorDirection, SectorHalfAngleCos);
+        bAllMatched &= KernelBest == ScalarBest;
+
+        std::printf("%4d candidates: kernel %8.1f ns, scalar %8.1f ns (%.2fx)%s\n",
+            NumCandidates,
+            KernelNs,
+            ScalarNs,
+            ScalarNs / KernelNs,
+            KernelBest == ScalarBest ? "" : " MISMATCH");
+        if (Log)
+        {
+            std::fprintf(Log,
+                "target_scoring_kernel: %d candidates, kernel %.1f ns, scalar %.1f ns%s\n",
+                NumCandidates,
+                KernelNs,
+                ScalarNs,
+                KernelBest == ScalarBest ? "" : " (mismatch)");
+        }
+    }
+
+    if (Log)
+    {
+        std::fclose(Log);
+    }
+    return bAllMatched ? 0 : 1;
+}
@@ -21,6 +21,7 @@
 #include "AI/MilVerseStateTreeTask.h"
 #include "Components/Engagement/AimComponent.h"
 #include "Components/UnrealActorComponent.h"
+#include "EntityAI/TaskWaitSubsystem.h"
 
 // Unreal Engine
 #include "CoreMinimal.h"
@@ -40,6 +41,13 @@ struct SIMULATIONBEHAVIORS_API FChangeOrientationTaskInstanceData
     UPROPERTY(EditAnywhere, Category = Input)
     double YawOrientation_deg = 0.0;
 
+    /// @brief Time to complete the turn, in seconds.
+    UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = "0.0"))
+    float TurnDuration = 0.5f;
+
+    /// @brief Wait on the entity's `ORIENTATION_COMPLETED` signal.
+    FTaskWaitHandle TransitionWait;
+
     /// @brief Used to track time between frames for a system.
     SimTimer SimClock;
 };
@@ -52,6 +60,10 @@ struct SIMULATIONBEHAVIORS_API FChangeOrientationTaskInstanceData
 /// The input is a desired Orientation. The task is successful when the Avatar's Orientation
 /// matches the desired Orientation.
 ///
+/// The turn itself is driven by @ref UKinematicTransitionSubsystem, which writes the interpolated
+/// yaw to the avatar every frame. The task starts it on enter and is parked until the subsystem
+/// signals completion.
+///
 /// @ingroup SimulationBehaviors-Module
 /// @ingroup EntityAI
 USTRUCT(meta = (MilVerseEntityLevel))
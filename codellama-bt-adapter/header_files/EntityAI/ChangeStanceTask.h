@@ -20,6 +20,8 @@
 // MilVerse
 #include "AI/MilVerseStateTreeTask.h"
 #include "Components/Avatar/AvatarControlComponent.h"
+#include "EntityAI/TaskTimerWheel.h"
+#include "EntityAI/TaskWaitSubsystem.h"
 #include "SimTimer.h"
 
 // Unreal Engine
@@ -40,12 +42,24 @@ struct SIMULATIONBEHAVIORS_API FChangeStanceTaskInstanceData
     UPROPERTY(EditAnywhere, Category = Parameter)
     EAvatarStances InStance = EAvatarStances::NONE;
 
-    /// @brief Remaining time before the end of the task. Internal countdown in seconds.
-    /// Allows the animation to complete
+    /// @brief Time allowed for the stance animation to complete, in seconds.
+    ///
+    /// Passed to `UKinematicTransitionSubsystem` when the state is entered, and registered with
+    /// `UTaskTimerSubsystem` as the deadline of the stance change, rather than counted down every
+    /// tick.
     /// TODO: Bind this value to the remaining animation time
     UPROPERTY()
     float RemainingTime = 0.5f;
 
+    /// @brief Wait on the entity's `STANCE_COMPLETED` signal.
+    FTaskWaitHandle TransitionWait;
+
+    /// @brief Expiry of the stance change registered with `UTaskTimerSubsystem`.
+    ///
+    /// If it expires before `STANCE_COMPLETED` is signalled the task checks the avatar's stance
+    /// and fails if the desired stance was not reached.
+    FTaskTimerHandle TimerHandle;
+
     /// @brief Used to track time between frames for a system.
     SimTimer SimClock;
 };
@@ -58,6 +72,12 @@ struct SIMULATIONBEHAVIORS_API FChangeStanceTaskInstanceData
 /// The input is a desired stance. The task is successful when the Avatar's stance
 /// matches the desired stance.
 ///
+/// The stance change is driven by @ref UKinematicTransitionSubsystem together with every other
+/// in-progress transition; the stance is requested on the avatar when the state is entered. The
+/// task does not tick while the animation plays; it is parked until
+/// the subsystem signals `STANCE_COMPLETED`, or until its deadline of `RemainingTime` plus
+/// `DeadlineSlackSeconds` is woken by the matching `TaskTimerExpiredEvent`.
+///
 /// @ingroup SimulationBehaviors-Module
 /// @ingroup EntityAI
 USTRUCT(meta = (MilVerseEntityLevel))
@@ -68,6 +88,9 @@ struct SIMULATIONBEHAVIORS_API FChangeStanceTask : public FMilVerseStateTreeTask
     /// @brief Alias for this task's instance data type.
     using FInstanceDataType = FChangeStanceTaskInstanceData;
 
+    /// @brief Time added to the deadline so that the subsystem completes the transition first.
+    static constexpr float DeadlineSlackSeconds = 0.1f;
+
 protected:
     /// @brief Called when the state tree asset is linked with data to allow the task to resolve
     /// references to other state tree data.
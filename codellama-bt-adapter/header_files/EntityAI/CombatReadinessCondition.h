@@ -47,6 +47,10 @@ struct FCombatReadinessConditionInstanceData
 
 /// @brief State tree condition for determining if an entity is ready to attack.
 ///
+/// Readiness is maintained by `UCombatReadinessSubsystem` whenever the entity's health, ammunition
+/// or fuel changes and written to `FCombatReadinessComponent`; testing the condition is a single
+/// comparison.
+///
 /// This condition requires that the entity have the following components assigned:
 /// * `FCombatReadinessComponent`
 ///
@@ -28,26 +28,15 @@
 #include "Components/InventoryComponent.h"
 #include "Components/Sensing/ShotAtDetectionComponent.h"
 #include "Components/UnitIdentifierComponent.h"
+#include "EntityAI/PlatformTypeWeapons.h"
+#include "EntityAI/PlatformWeaponCompatibilityMatrix.h"
+#include "EntityAI/TaskTimerWheel.h"
+#include "EntityAI/ThreatTrackSubsystem.h"
+#include "EntityAI/WeaponTemplateRegistry.h"
 #include "SimTimer.h"
 
 #include "EnemySituationEvaluator.generated.h"
 
-/// @brief Contains all the weapons that can be used to fire at the specific
-/// platform type
-USTRUCT(BlueprintType)
-struct FPlatformTypeWeapons
-{
-    GENERATED_BODY()
-
-    UPROPERTY(EditAnywhere, Category = "Parameter")
-    /// @brief The platform type (e.g. Vehicle, Person, etc.)
-    PlatformTypes PlatformType = PlatformTypes::Vehicle;
-
-    UPROPERTY(EditAnywhere, Category = "Parameter")
-    /// @brief The weapon template names that can be used to fire at the platform type
-    TArray<FName> CompatibleWeapons;
-};
-
 /// @brief Instance data for `FEnemySituationEvaluator`.
 ///
 /// @ingroup SimulationBehaviors-Module
@@ -88,26 +77,53 @@ struct FEnemySituationEvaluatorInstanceData
 
     UPROPERTY(EditAnywhere, Category = "Parameter")
     /// @brief The different platform types and the weapons that can be fired at them
+    ///
+    /// Compiled into `PlatformWeaponCompatibility` when the tree starts; not read per threat.
     TArray<FPlatformTypeWeapons> PlatformTypeWeapons;
 
+    /// @brief `PlatformTypeWeapons` compiled into a (platform type, weapon template) bit matrix.
+    FPlatformWeaponCompatibilityMatrix PlatformWeaponCompatibility;
+
+    /// @brief Platform types engageable with the weapons in `WeaponTemplateIndices`.
+    ///
+    /// Refreshed together with `WeaponTemplateIndices`; the per-threat platform check is a single
+    /// bit test against this mask.
+    uint32 EngageablePlatformMask = 0;
+
     UPROPERTY(EditAnywhere, Category = "Output")
     /// @brief A prioritized array of targets
     FEnemySituation EnemySituation;
 
     UPROPERTY()
     /// @brief Max engagement distance for entity.
+    ///
+    /// Taken from `UWeaponTemplateRegistry` whenever `WeaponTemplateIndices` is refreshed.
     float MaxEngagementDistance = 0.0;
 
+    /// @brief Registry indices of the weapon templates carried by the entity.
+    ///
+    /// Rebuilt from the inventory only when the set of carried weapons changes.
+    TArray<int32> WeaponTemplateIndices;
+
     /// @brief The time remaining, in seconds, until we update the prioritized list of threats.
     float TimeRemainingBeforNextThreatListUpdate = -1.0f;
 
+    /// @brief Pending shot-at notification registered with `UTaskTimerSubsystem`.
+    ///
+    /// Scheduled for `TimeUntilShotAtDetectionUpdate` seconds when the entity is shot at instead
+    /// of counting the delay down every tick.
+    FTaskTimerHandle ShotAtDetectionUpdateTimer;
+
     /// @brief Used to track time between frames for a system.
     SimTimer SimClock;
 };
 
 /// @brief Evaluates potential targets and sorts them based upon priority
 ///
-///
+/// Threat information for each sensed enemy is read from `UThreatTrackSubsystem` when another
+/// entity or unit of the same side has reported a sample at least as fresh as this entity's
+/// sensing; otherwise this entity's sample is derived and fused into the track. The priority of
+/// each threat is scored here from the shared track, against this entity's position and weapons.
 ///
 /// @ingroup SimulationBehaviors-Module
 /// @ingroup EntityAI
@@ -140,12 +156,11 @@ struct FEnemySituationEvaluator : public FMilVerseStateTreeEvaluator
     }
 
     /**
-     * Called when StateTree is started.
+     * Called when StateTree is started. Compiles `PlatformTypeWeapons` into the instance's
+     * compatibility matrix.
      * @param Context Reference to current execution context.
      */
-    virtual void TreeStart(FStateTreeExecutionContext& Context) const override
-    {
-    }
+    virtual void TreeStart(FStateTreeExecutionContext& Context) const override;
 
     /**
      * Called when StateTree is stopped.
@@ -25,6 +25,7 @@
 #include "Components/Engagement/TargetComponent.h"
 #include "Components/HealthComponent.h"
 #include "Components/Sensing/SensedEntitiesComponent.h"
+#include "EntityAI/FireControlSubsystem.h"
 
 // Unreal
 #include "CoreMinimal.h"
@@ -51,7 +52,8 @@ struct SIMULATIONBEHAVIORS_API FEngageTargetTaskInstanceData
 /// `FSensedEntitiesComponent`
 /// `FTargetComponent`
 ///
-/// Shoots at a target until the target is dead.
+/// Shoots at a target until the target is dead. Shots are queued with @ref UFireControlSubsystem,
+/// which dispatches them in batches with every other shot of the frame.
 /// Returns Success when the target is dead.
 /// Returns Failed when the target is no longer sensed.
 /// Returns Running if the target is alive and sensed.
@@ -27,7 +27,9 @@
 #include "Components/Engagement/RulesOfEngagementComponent.h"
 #include "Components/EntityStateComponent.h"
 #include "Components/InventoryComponent.h"
+#include "Components/UnitIdentifierComponent.h"
 #include "SimTimer.h"
+#include "EntityAI/UnitRulesOfEngagementSubsystem.h"
 
 #include "EngagementConditions.generated.h"
 
@@ -125,6 +127,18 @@ private:
 
 // --------------------------------------------------------------------------
 
+/// @brief Which ROE `FRulesOfEngagementCondition` tests.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UENUM()
+enum class ERulesOfEngagementSource : uint8
+{
+    ENTITY,            ///< @brief Only the entity's `FRulesOfEngagementComponent`.
+    UNIT_THEN_ENTITY,  ///< @brief The unit's published ROE, or the entity's own when there is none.
+    UNIT               ///< @brief Only the unit's published ROE; fails when there is none.
+};
+
 /// @brief Instance data for `FRulesOfEngagementCondition`.
 ///
 /// @ingroup SimulationBehaviors-Module
@@ -137,6 +151,17 @@ struct FRulesOfEngagementConditionInstanceData
 
 /// @brief State tree condition for checking the Rules of Engagement (ROE)
 ///
+/// `SelectedROEs` is compiled into `SelectedROEMask` when the tree is linked, so testing the
+/// condition is a single AND with the current ROE mask. Which ROE is current is chosen by
+/// `ROESource`. By default (`ENTITY`) only the entity's own `FRulesOfEngagementComponent` is
+/// tested. With `UNIT_THEN_ENTITY` the unit's ROE, as published by the order system to
+/// `UUnitRulesOfEngagementSubsystem`, takes precedence, and the entity's own is only used when the
+/// entity has no unit or its unit has no published ROE.
+///
+/// `RulesOfEngagementChangedEvent` is only sent when a unit's published ROE changes, not when the
+/// entity's own component does. States that re-evaluate only on that event therefore miss changes
+/// to the entity's ROE, and should only rely on it with `ROESource` set to `UNIT`.
+///
 /// This condition requires that the entity have the following components assigned:
 /// * `FRulesOfEngagementComponent`
 ///
@@ -176,8 +201,8 @@ protected:
     /// @param Context
     ///     The state tree context.
     /// @returns
-    ///     True if the entity's current ROE type matches any of
-    ///     the `SelectedROEs` or false otherwise.
+    ///     True if the ROE chosen by `ROESource` matches any of the `SelectedROEs`. False otherwise,
+    ///     or if `ROESource` is `UNIT` and the entity's unit has no published ROE.
     virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
 
 protected:
@@ -187,7 +212,18 @@ protected:
     UPROPERTY(EditAnywhere, Category = Condition)
     TArray<ERulesOfEngagementTypes> SelectedROEs = {ERulesOfEngagementTypes::NONE};
 
+    /// @brief Which ROE is tested: the entity's, the unit's, or the unit's with the entity's as a
+    /// fallback. Unit precedence is opt-in.
+    UPROPERTY(EditAnywhere, Category = Condition)
+    ERulesOfEngagementSource ROESource = ERulesOfEngagementSource::ENTITY;
+
+    /// @brief `SelectedROEs` compiled with `FRulesOfEngagementMask::Compile` in `Link`.
+    uint32 SelectedROEMask = 0;
+
 protected:
     /// @brief Handle for the `FRulesOfEngagementComponent` ECS component.
     TStateTreeExternalDataHandle<FRulesOfEngagementComponent> ROEHandle;
+
+    /// @brief Optional handle for the `FUnitIdentifierComponent` ECS component.
+    TOptionalStateTreeExternalDataHandle<FUnitIdentifierComponent> UnitIdentifierHandle;
 };
\ No newline at end of file
@@ -0,0 +1,150 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UFireControlSubsystem class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "Components/Weapons/WeaponEnumerations.h"
+
+// Unreal Engine
+#include "Containers/Queue.h"
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FireControlSubsystem.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief A single request to fire, queued by a state tree task.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FFireRequest
+{
+    /// @brief Entity firing the weapon.
+    FGuid ShooterId;
+
+    /// @brief Entity being fired at. Not valid for area (suppression) fire.
+    FGuid TargetId;
+
+    /// @brief Point being fired at, in Unreal world space.
+    FVector AimPoint = FVector::ZeroVector;
+
+    /// @brief Index of the firing weapon's template in `UWeaponTemplateRegistry`.
+    int32 WeaponTemplateIndex = INDEX_NONE;
+
+    /// @brief Firing mode of the weapon.
+    EFiringModes FiringMode = EFiringModes::SAFE;
+
+    /// @brief How long the trigger is held, in seconds.
+    float TriggerHoldTime = 0.f;
+
+    /// @brief Real time at which the request was queued, in seconds. Used for latency stats.
+    double QueuedTimeSeconds = 0.0;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Per-frame throughput and latency counters of @ref UFireControlSubsystem.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+USTRUCT()
+struct SIMULATIONBEHAVIORS_API FFireControlStats
+{
+    GENERATED_BODY()
+
+    /// @brief Requests dispatched during the last frame.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int32 RequestsLastFrame = 0;
+
+    /// @brief Batches (one per weapon template) dispatched during the last frame.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int32 BatchesLastFrame = 0;
+
+    /// @brief Mean queue-to-dispatch latency during the last frame, in seconds.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    double MeanLatencySecondsLastFrame = 0.0;
+
+    /// @brief Largest queue-to-dispatch latency during the last frame, in seconds.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    double MaxLatencySecondsLastFrame = 0.0;
+
+    /// @brief Requests dispatched since the subsystem was created.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int64 TotalRequests = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Centralized fire-control scheduler.
+///
+/// Firing tasks (@ref FEngageTargetTask, @ref FSuppressionFireTask) queue an `FFireRequest`
+/// instead of triggering `FFireWeaponComponent` from their own tick. The queue is a lock-free
+/// multi-producer queue, so requests can be made from parallel state tree ticks. Once per frame
+/// the subsystem drains it, sorts the requests by weapon template and hands each run of
+/// requests for the same weapon system to the ballistics and effects layer as one batch.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UFireControlSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Queues a request to fire. Safe to call from any thread.
+    ///
+    /// @param Request
+    ///     The shot to fire. `QueuedTimeSeconds` is stamped by this call.
+    void QueueFire(FFireRequest Request);
+
+    /// @brief Returns the counters of the last frame.
+    const FFireControlStats& GetStats() const
+    {
+        return Stats;
+    }
+
+    /// @brief Drains, sorts and dispatches the requests queued since the last frame.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed time in seconds. Not used.
+    virtual void Tick(float DeltaTime) override;
+
+    /// @brief Returns the stat id used to profile this subsystem.
+    virtual TStatId GetStatId() const override;
+
+private:
+    /// @brief Sends all requests for one weapon template to the ballistics and effects layer.
+    ///
+    /// Each request is also registered with `ULineOfFireSubsystem` as a line of fire from the
+    /// shooter to its aim point.
+    ///
+    /// @param WeaponTemplateIndex
+    ///     The weapon template shared by every request in the batch.
+    /// @param Batch
+    ///     The requests to fire.
+    void DispatchBatch(const int32 WeaponTemplateIndex, TConstArrayView<FFireRequest> Batch);
+
+    /// @brief Requests queued since the last frame.
+    TQueue<FFireRequest, EQueueMode::Mpsc> PendingRequests;
+
+    /// @brief Scratch buffer the queue is drained into. Reused every frame.
+    TArray<FFireRequest> FrameRequests;
+
+    /// @brief Counters of the last frame.
+    FFireControlStats Stats;
+};
@@ -22,6 +22,7 @@
 #include "Components/EntityStateComponent.h"
 #include "Components/HealthComponent.h"
 #include "Components/MoveToComponent.h"
+#include "Components/UnitIdentifierComponent.h"
 #include "EntityAI/MoveTaskDataComponent.h"
 
 #include "SimTimer.h"
@@ -82,9 +83,14 @@ struct SIMULATIONBEHAVIORS_API FFollowLeaderTaskInstanceData
     bool bAllowedToFormUpAgain = false;
 
     /// @brief Flag to determine whether we should halt movement.
+    ///
+    /// Movement is also halted while the entity's unit is halted in `UUnitHaltSubsystem`.
     UPROPERTY(EditAnywhere, Category = Parameter)
     bool bIsHalted = false;
 
+    /// @brief Serial of the last unit halt for which zero velocity was reported.
+    uint32 ReportedHaltSerial = 0;
+
     //
     // Conditional Parameters
     //
@@ -233,6 +239,10 @@ protected:
     /// @brief Handle for the 'FHealthComponent' ECS component.
     TStateTreeExternalDataHandle<FHealthComponent> HealthHandle;
 
+    /// @brief Optional handle for the `FUnitIdentifierComponent` ECS component. Used to look up
+    /// the unit-wide halt bit.
+    TOptionalStateTreeExternalDataHandle<FUnitIdentifierComponent> UnitIdentifierHandle;
+
 private:
     /// @brief Update the follower's movement based on the data provided by the formation manager.
     ///
@@ -40,9 +40,16 @@ struct SIMULATIONBEHAVIORS_API FFriendlyFireEvaluatorInstanceData
 /// @brief Fires a MilVerse.FriendlyFireStopMovement FStateTreeEvent when movement is impeded and
 /// fires a MilVerse.FriendlyFireStartMovement FStateTreeEvent when movement is no longer impeded.
 ///
+/// The impeding state is computed for every entity at once by `ULineOfFireSubsystem`, which
+/// tests all lines of fire of the frame against a spatial grid of friendlies and writes the
+/// result to `FFriendlyFireImpedingMovementComponent`. This evaluator only reacts to changes of
+/// that component; it does no geometry of its own.
+///
 /// This evaluator requires that the entity have the following components assigned:
 /// * FFriendlyFireImpedingMovementComponent
 ///
+/// @sa ULineOfFireSubsystem
+///
 /// @ingroup SimulationBehaviors-Module
 /// @ingroup EntityAI
 USTRUCT(meta = (DisplayName = "Friendly Fire Evaluator", MilVerseEntityLevel))
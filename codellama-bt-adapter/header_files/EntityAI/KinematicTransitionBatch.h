@@ -0,0 +1,215 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the packed storage and update kernel for kinematic transitions.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "KinematicTransitionBatch.generated.h"
+
+/// @brief Precomputed easing curves for orientation and stance transitions.
+UENUM()
+enum class EKinematicTransitionProfile : uint8
+{
+    LINEAR,       ///< @brief Constant rate from start to end.
+    EASE_IN_OUT   ///< @brief Accelerates then decelerates (smoothstep).
+};
+
+/// @brief Packed (structure of arrays) set of in-progress kinematic transitions.
+///
+/// Each transition interpolates a scalar from `Start` to `Start + Delta` over a fixed duration.
+/// Profiles are stored as cubic coefficients `p(t) = A t + B t^2 + C t^3` chosen when the
+/// transition starts, so `Advance` is a branch-free pass over contiguous float arrays that the
+/// compiler can vectorize, instead of one interpolation per task tick.
+///
+/// Orientation transitions interpolate yaw in degrees along the shortest arc. Stance transitions
+/// interpolate a 0-1 blend weight. The owner of the batch reads the interpolated values back
+/// from `Value` after each pass, e.g. through `FindValue`.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FKinematicTransitionBatch
+{
+    /// @brief Owning entity of each transition.
+    TArray<FGuid> EntityIds;
+
+    /// @brief Value at the start of each transition.
+    TArray<float> Start;
+
+    /// @brief Total change of each transition.
+    TArray<float> Delta;
+
+    /// @brief Time elapsed in each transition, in seconds.
+    TArray<float> Elapsed;
+
+    /// @brief Reciprocal of each transition's duration.
+    TArray<float> InvDuration;
+
+    /// @brief Profile coefficients of each transition.
+    TArray<float> CoeffA;
+    TArray<float> CoeffB;
+    TArray<float> CoeffC;
+
+    /// @brief Current value of each transition, written by `Advance`.
+    TArray<float> Value;
+
+    /// @brief Index of each entity's transition in the arrays above.
+    TMap<FGuid, int32> IndexByEntityId;
+
+    /// @brief Returns the number of transitions in progress.
+    int32 Num() const
+    {
+        return EntityIds.Num();
+    }
+
+    /// @brief Returns the current value of the entity's transition, or `nullptr` if it has none.
+    const float* FindValue(const FGuid& EntityId) const
+    {
+        const int32* Index = IndexByEntityId.Find(EntityId);
+        return Index != nullptr ? &Value[*Index] : nullptr;
+    }
+
+    /// @brief Starts a transition, replacing any transition already in progress for the entity.
+    ///
+    /// @param EntityId
+    ///     Owning entity.
+    /// @param From
+    ///     Starting value.
+    /// @param To
+    ///     Target value.
+    /// @param Duration
+    ///     Length of the transition in seconds. Non-positive durations complete on the next pass.
+    /// @param Profile
+    ///     Easing curve to follow.
+    void Add(const FGuid& EntityId,
+        const float From,
+        const float To,
+        const float Duration,
+        const EKinematicTransitionProfile Profile)
+    {
+        Remove(EntityId);
+
+        float A = 1.f;
+        float B = 0.f;
+        float C = 0.f;
+        if (Profile == EKinematicTransitionProfile::EASE_IN_OUT)
+        {
+            A = 0.f;
+            B = 3.f;
+            C = -2.f;
+        }
+
+        IndexByEntityId.Add(EntityId, EntityIds.Add(EntityId));
+        Start.Add(From);
+        Delta.Add(To - From);
+        Elapsed.Add(0.f);
+        InvDuration.Add(Duration > UE_KINDA_SMALL_NUMBER ? 1.f / Duration : UE_BIG_NUMBER);
+        CoeffA.Add(A);
+        CoeffB.Add(B);
+        CoeffC.Add(C);
+        Value.Add(From);
+    }
+
+    /// @brief Starts an orientation transition along the shortest arc between two yaws (degrees).
+    void AddYaw(const FGuid& EntityId,
+        const float FromYaw,
+        const float ToYaw,
+        const float Duration,
+        const EKinematicTransitionProfile Profile)
+    {
+        Add(EntityId, FromYaw, FromYaw + FRotator::NormalizeAxis(ToYaw - FromYaw), Duration, Profile);
+    }
+
+    /// @brief Removes the entity's transition, if any. Does not preserve ordering.
+    ///
+    /// @returns
+    ///     `true` if a transition was removed.
+    bool Remove(const FGuid& EntityId)
+    {
+        const int32* Index = IndexByEntityId.Find(EntityId);
+        if (Index == nullptr)
+        {
+            return false;
+        }
+        RemoveAt(*Index);
+        return true;
+    }
+
+    /// @brief Advances every transition by `DeltaTime` and extracts the completed ones.
+    ///
+    /// After the pass, `Value` holds the interpolated value of every transition still in progress.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed simulation time in seconds.
+    /// @param OutCompletedIds
+    ///     Appended with the entities whose transition completed during this pass.
+    /// @param OutCompletedValues
+    ///     Appended with the final value of each completed transition.
+    void Advance(const float DeltaTime, TArray<FGuid>& OutCompletedIds, TArray<float>& OutCompletedValues)
+    {
+        const int32 Count = Num();
+        float* RESTRICT ElapsedData = Elapsed.GetData();
+        float* RESTRICT ValueData = Value.GetData();
+        const float* RESTRICT StartData = Start.GetData();
+        const float* RESTRICT DeltaData = Delta.GetData();
+        const float* RESTRICT InvDurationData = InvDuration.GetData();
+        const float* RESTRICT AData = CoeffA.GetData();
+        const float* RESTRICT BData = CoeffB.GetData();
+        const float* RESTRICT CData = CoeffC.GetData();
+
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const float NewElapsed = ElapsedData[Index] + DeltaTime;
+            const float T = FMath::Min(NewElapsed * InvDurationData[Index], 1.f);
+            const float Progress = T * (AData[Index] + T * (BData[Index] + T * CData[Index]));
+            ElapsedData[Index] = NewElapsed;
+            ValueData[Index] = StartData[Index] + DeltaData[Index] * Progress;
+        }
+
+        // Completions are rare compared to the update, so they are extracted in a second pass.
+        for (int32 Index = Count - 1; Index >= 0; --Index)
+        {
+            if (ElapsedData[Index] * InvDurationData[Index] >= 1.f)
+            {
+                OutCompletedIds.Add(EntityIds[Index]);
+                OutCompletedValues.Add(StartData[Index] + DeltaData[Index]);
+                RemoveAt(Index);
+            }
+        }
+    }
+
+private:
+    /// @brief Removes a transition by swapping the last one into its place.
+    void RemoveAt(const int32 Index)
+    {
+        IndexByEntityId.Remove(EntityIds[Index]);
+        if (Index != EntityIds.Num() - 1)
+        {
+            IndexByEntityId.Add(EntityIds.Last(), Index);
+        }
+
+        EntityIds.RemoveAtSwap(Index, 1, false);
+        Start.RemoveAtSwap(Index, 1, false);
+        Delta.RemoveAtSwap(Index, 1, false);
+        Elapsed.RemoveAtSwap(Index, 1, false);
+        InvDuration.RemoveAtSwap(Index, 1, false);
+        CoeffA.RemoveAtSwap(Index, 1, false);
+        CoeffB.RemoveAtSwap(Index, 1, false);
+        CoeffC.RemoveAtSwap(Index, 1, false);
+        Value.RemoveAtSwap(Index, 1, false);
+    }
+};
@@ -0,0 +1,133 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UKinematicTransitionSubsystem class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "Components/Avatar/AvatarControlComponent.h"
+#include "EntityAI/KinematicTransitionBatch.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "KinematicTransitionSubsystem.generated.h"
+
+/// @brief Shared driver for in-progress orientation and stance transitions.
+///
+/// @ref FChangeOrientationTask and @ref FChangeStanceTask only start a transition here and then
+/// park with @ref UTaskWaitSubsystem on the entity's `ORIENTATION_COMPLETED` or `STANCE_COMPLETED`
+/// signal respectively, so finishing one kind of transition does not wake the other task. All
+/// transitions are held in packed arrays and advanced in a single pass per frame, so a unit-wide
+/// stance change (e.g. "go prone" on contact) costs one loop over contiguous data rather than
+/// thousands of task ticks.
+///
+/// Each frame, after the packed update, the interpolated yaw of every turn in progress is written
+/// to its entity, so turns follow their easing profile instead of snapping at the end. A stance
+/// change requests the stance on the avatar when it starts, so the stance animation plays while
+/// the transition runs; its 0-1 blend weight is available through `GetStanceBlendWeight`. On
+/// completion the final yaw is written and the signal of that transition kind is raised.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UKinematicTransitionSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Starts turning an entity to a yaw, replacing any turn already in progress.
+    ///
+    /// @param GlobalEntityId
+    ///     The entity to turn.
+    /// @param FromYaw_deg
+    ///     Current yaw in degrees (unreal orientation).
+    /// @param ToYaw_deg
+    ///     Desired yaw in degrees (unreal orientation).
+    /// @param Duration
+    ///     Time to complete the turn, in seconds.
+    /// @param Profile
+    ///     Easing curve of the turn.
+    void StartOrientationChange(const FGuid& GlobalEntityId,
+        const float FromYaw_deg,
+        const float ToYaw_deg,
+        const float Duration,
+        const EKinematicTransitionProfile Profile = EKinematicTransitionProfile::EASE_IN_OUT);
+
+    /// @brief Starts changing an entity's stance, replacing any stance change already in progress.
+    ///
+    /// @param GlobalEntityId
+    ///     The entity changing stance.
+    /// @param Stance
+    ///     The stance requested on the avatar when the transition starts.
+    /// @param Duration
+    ///     Time allowed for the stance animation, in seconds.
+    void StartStanceChange(const FGuid& GlobalEntityId,
+        const EAvatarStances Stance,
+        const float Duration);
+
+    /// @brief Stops any transition in progress for the entity, typically from `ExitState`.
+    void CancelTransitions(const FGuid& GlobalEntityId);
+
+    /// @brief Returns `true` if the entity has an orientation or stance transition in progress.
+    bool IsTransitioning(const FGuid& GlobalEntityId) const;
+
+    /// @brief Returns the interpolated yaw of the entity's turn in progress.
+    ///
+    /// @param GlobalEntityId
+    ///     The turning entity.
+    /// @param OutYaw_deg
+    ///     Set to the yaw written to the entity this frame, in degrees (unreal orientation).
+    /// @returns
+    ///     `false` if the entity is not turning.
+    bool GetCurrentYaw(const FGuid& GlobalEntityId, float& OutYaw_deg) const;
+
+    /// @brief Returns the 0-1 blend weight of the entity's stance change in progress, or 1 if the
+    /// entity is not changing stance.
+    float GetStanceBlendWeight(const FGuid& GlobalEntityId) const;
+
+    /// @brief Advances every transition, writes the interpolated yaws to their entities and
+    /// completes the finished transitions.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed simulation time in seconds.
+    virtual void Tick(float DeltaTime) override;
+
+    /// @brief Returns the stat id used to profile this subsystem.
+    virtual TStatId GetStatId() const override;
+
+private:
+    /// @brief Writes a yaw to the entity's avatar.
+    ///
+    /// @param GlobalEntityId
+    ///     The entity to orient.
+    /// @param Yaw_deg
+    ///     Yaw in degrees (unreal orientation).
+    void ApplyYaw(const FGuid& GlobalEntityId, const float Yaw_deg) const;
+
+    /// @brief In-progress orientation changes, in degrees.
+    FKinematicTransitionBatch OrientationTransitions;
+
+    /// @brief In-progress stance changes, as a 0-1 blend weight.
+    FKinematicTransitionBatch StanceTransitions;
+
+    /// @brief Stance requested by each entity's stance transition in progress.
+    TMap<FGuid, EAvatarStances> TargetStances;
+
+    /// @brief Scratch buffers reused by `Tick` to avoid per-frame allocations.
+    TArray<FGuid> CompletedIds;
+    TArray<float> CompletedValues;
+};
@@ -0,0 +1,279 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the batched line-of-fire checker used for friendly fire avoidance.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// Unreal Engine
+#include "CoreMinimal.h"
+
+/// @brief A line of fire to test against friendlies.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FLineOfFire
+{
+    /// @brief Entity firing. Never reported as impeding its own line.
+    FGuid ShooterId;
+
+    /// @brief Side of the shooter. Only friendlies of the same side are tested.
+    int32 Side = 0;
+
+    /// @brief Muzzle position, in Unreal world space.
+    FVector Start = FVector::ZeroVector;
+
+    /// @brief Aim point, in Unreal world space.
+    FVector End = FVector::ZeroVector;
+};
+
+/// @brief Tests every line of fire in a frame against every nearby friendly at once.
+///
+/// Friendlies are modelled as vertical capsules and bucketed into a uniform grid in the ground
+/// plane. Within a cell they are stored as contiguous arrays, so a line is tested against all
+/// the friendlies of a cell by a branch-free segment-vs-capsule loop the compiler vectorizes.
+/// Each line samples its length at most one `CellSize` apart and tests the 3x3 cells around each
+/// sample. A point of the line is then at most half a cell from a sample, so the neighbourhood
+/// covers every capsule whose radius is at most `0.5 * CellSize`; `AddFriendly` checks this. Cost
+/// grows with line length and local density rather than with the number of shooters times the
+/// number of friendlies.
+///
+/// Usage per frame: `Reset`, `AddFriendly` for every entity, `BuildGrid`, then
+/// `FindImpeded` with every line of fire.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+class FLineOfFireChecker
+{
+public:
+    /// @brief Width of a grid cell, in Unreal units (cm).
+    float CellSize = 2000.f;
+
+    /// @brief Removes all friendlies.
+    void Reset()
+    {
+        Ids.Reset();
+        Sides.Reset();
+        X.Reset();
+        Y.Reset();
+        Z.Reset();
+        RadiusSq.Reset();
+        HalfHeight.Reset();
+        CellKeys.Reset();
+        Cells.Reset();
+    }
+
+    /// @brief Adds a friendly capsule.
+    ///
+    /// @param Id
+    ///     Global id of the entity.
+    /// @param Side
+    ///     Side of the entity.
+    /// @param Position
+    ///     Centre of the capsule, in Unreal world space.
+    /// @param Radius
+    ///     Radius of the capsule, in Unreal units. Must not exceed `0.5 * CellSize`, or the
+    ///     capsule could be missed by lines passing through a cell next to its own.
+    /// @param InHalfHeight
+    ///     Half height of the capsule, in Unreal units.
+    void AddFriendly(const FGuid& Id,
+        const int32 Side,
+        const FVector& Position,
+        const float Radius,
+        const float InHalfHeight)
+    {
+        check(Radius <= 0.5f * CellSize);
+
+        Ids.Add(Id);
+        Sides.Add(Side);
+        X.Add(Position.X);
+        Y.Add(Position.Y);
+        Z.Add(Position.Z);
+        RadiusSq.Add(Radius * Radius);
+        HalfHeight.Add(InHalfHeight);
+        CellKeys.Add(CellKey(CellCoord(Position.X), CellCoord(Position.Y)));
+    }
+
+    /// @brief Returns the number of friendlies.
+    int32 Num() const
+    {
+        return Ids.Num();
+    }
+
+    /// @brief Returns the id of the friendly at an index in the sorted order used by results.
+    const FGuid& GetId(const int32 Index) const
+    {
+        return Ids[Index];
+    }
+
+    /// @brief Sorts the friendlies by grid cell. Must be called after the last `AddFriendly`.
+    void BuildGrid()
+    {
+        TArray<int32> Order;
+        Order.SetNumUninitialized(Num());
+        for (int32 Index = 0; Index < Num(); ++Index)
+        {
+            Order[Index] = Index;
+        }
+        Order.Sort([this](const int32 Lhs, const int32 Rhs) { return CellKeys[Lhs] < CellKeys[Rhs]; });
+
+        Permute(Ids, Order);
+        Permute(Sides, Order);
+        Permute(X, Order);
+        Permute(Y, Order);
+        Permute(Z, Order);
+        Permute(RadiusSq, Order);
+        Permute(HalfHeight, Order);
+        Permute(CellKeys, Order);
+
+        Cells.Reset();
+        for (int32 Index = 0; Index < Num(); ++Index)
+        {
+            FCellRange& Range = Cells.FindOrAdd(CellKeys[Index], FCellRange{Index, 0});
+            ++Range.Num;
+        }
+    }
+
+    /// @brief Finds the friendlies standing in any of the lines of fire.
+    ///
+    /// @param Lines
+    ///     All lines of fire of the frame.
+    /// @param OutImpeded
+    ///     Resized to `Num()`; bit `i` is set if friendly `GetId(i)` is in a line of fire.
+    void FindImpeded(TConstArrayView<FLineOfFire> Lines, TBitArray<>& OutImpeded) const
+    {
+        OutImpeded.Init(false, Num());
+        TSet<int64> VisitedCells;
+
+        for (const FLineOfFire& Line : Lines)
+        {
+            const FVector Delta = Line.End - Line.Start;
+            const float LengthSq2D = Delta.X * Delta.X + Delta.Y * Delta.Y;
+            const float InvLengthSq2D = LengthSq2D > UE_KINDA_SMALL_NUMBER ? 1.f / LengthSq2D : 0.f;
+            const int32 NumSteps = FMath::CeilToInt(FMath::Sqrt(LengthSq2D) / CellSize) + 1;
+
+            VisitedCells.Reset();
+            for (int32 Step = 0; Step <= NumSteps; ++Step)
+            {
+                const float Alpha = static_cast<float>(Step) / NumSteps;
+                const int32 CellX = CellCoord(Line.Start.X + Delta.X * Alpha);
+                const int32 CellY = CellCoord(Line.Start.Y + Delta.Y * Alpha);
+                for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+                {
+                    for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+                    {
+                        const int64 Key = CellKey(CellX + OffsetX, CellY + OffsetY);
+                        bool bAlreadyVisited = false;
+                        VisitedCells.Add(Key, &bAlreadyVisited);
+                        if (bAlreadyVisited)
+                        {
+                            continue;
+                        }
+                        if (const FCellRange* Range = Cells.Find(Key))
+                        {
+                            TestCell(Line, Delta, InvLengthSq2D, *Range, OutImpeded);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    /// @brief Contiguous run of friendlies sharing a grid cell.
+    struct FCellRange
+    {
+        int32 Start = 0;
+        int32 Num = 0;
+    };
+
+    /// @brief Maximum number of friendlies tested by one pass of the kernel.
+    static constexpr int32 KernelWidth = 64;
+
+    /// @brief Tests a line against every friendly of a cell.
+    void TestCell(const FLineOfFire& Line,
+        const FVector& Delta,
+        const float InvLengthSq2D,
+        const FCellRange& Range,
+        TBitArray<>& OutImpeded) const
+    {
+        for (int32 Chunk = Range.Start; Chunk < Range.Start + Range.Num; Chunk += KernelWidth)
+        {
+            const int32 Count = FMath::Min(KernelWidth, Range.Start + Range.Num - Chunk);
+            bool Hits[KernelWidth];
+
+            // Closest point of the segment to each capsule axis in the ground plane, then a
+            // height test at that point. No branches, so this loop is vectorized.
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                const int32 Friendly = Chunk + Index;
+                const float ToX = X[Friendly] - Line.Start.X;
+                const float ToY = Y[Friendly] - Line.Start.Y;
+                const float T = FMath::Clamp((ToX * Delta.X + ToY * Delta.Y) * InvLengthSq2D, 0.f, 1.f);
+                const float DX = ToX - Delta.X * T;
+                const float DY = ToY - Delta.Y * T;
+                const float DZ = FMath::Abs(Line.Start.Z + Delta.Z * T - Z[Friendly]);
+                Hits[Index] = (DX * DX + DY * DY <= RadiusSq[Friendly]) & (DZ <= HalfHeight[Friendly])
+                    & (Sides[Friendly] == Line.Side);
+            }
+
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                if (Hits[Index] && Ids[Chunk + Index] != Line.ShooterId)
+                {
+                    OutImpeded[Chunk + Index] = true;
+                }
+            }
+        }
+    }
+
+    /// @brief Returns the grid coordinate of a position.
+    int32 CellCoord(const float Position) const
+    {
+        return FMath::FloorToInt(Position / CellSize);
+    }
+
+    /// @brief Packs grid coordinates into a cell key.
+    static int64 CellKey(const int32 CellX, const int32 CellY)
+    {
+        return (static_cast<int64>(CellX) << 32) | static_cast<uint32>(CellY);
+    }
+
+    /// @brief Reorders an array so that element `i` becomes `Array[Order[i]]`.
+    template <typename ElementType>
+    static void Permute(TArray<ElementType>& Array, const TArray<int32>& Order)
+    {
+        TArray<ElementType> Sorted;
+        Sorted.Reserve(Array.Num());
+        for (const int32 Index : Order)
+        {
+            Sorted.Add(Array[Index]);
+        }
+        Array = MoveTemp(Sorted);
+    }
+
+    /// @brief Friendly data, sorted by cell once `BuildGrid` has run.
+    TArray<FGuid> Ids;
+    TArray<int32> Sides;
+    TArray<float> X;
+    TArray<float> Y;
+    TArray<float> Z;
+    TArray<float> RadiusSq;
+    TArray<float> HalfHeight;
+    TArray<int64> CellKeys;
+
+    /// @brief Range of friendlies in each occupied cell.
+    TMap<int64, FCellRange> Cells;
+};
@@ -0,0 +1,114 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the ULineOfFireSubsystem class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "EntityAI/LineOfFireChecker.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LineOfFireSubsystem.generated.h"
+
+/// @brief Computes, once per frame, which entities are standing in a friendly line of fire.
+///
+/// Previously every `FFriendlyFireEvaluator` tested its own entity against the lines of fire of
+/// the shooters around it, repeating the same geometry for each pair of neighbours. This
+/// subsystem gathers every entity's capsule and every line of fire queued with
+/// `UFireControlSubsystem` for the frame, runs a single `FLineOfFireChecker` pass over them and
+/// writes the result to each entity's `FFriendlyFireImpedingMovementComponent`. The evaluators
+/// then only read that component.
+///
+/// Lines of fire exist only on the frames where a shot is dispatched, so an entity stays in the
+/// impeded set for `ImpededHoldSeconds` after the last line that crossed it. Without the hold it
+/// would leave and re-enter the set between two shots of the same burst, and every change raises
+/// a FriendlyFireStop/StartMovement event.
+///
+/// @sa FFriendlyFireEvaluator
+/// @sa UFireControlSubsystem
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API ULineOfFireSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Time an entity stays impeded after the last line of fire that crossed it, in
+    /// seconds. Longer than the interval between two shots of a weapon.
+    static constexpr float ImpededHoldSeconds = 1.5f;
+
+    /// @brief Registers a line of fire for the current frame. Safe to call from any thread.
+    ///
+    /// @param Line
+    ///     The line of fire, from the shooter's muzzle to its aim point.
+    void AddLineOfFire(const FLineOfFire& Line);
+
+    /// @brief Returns `true` if the entity was in a friendly line of fire within the last
+    /// `ImpededHoldSeconds`.
+    ///
+    /// @param EntityId
+    ///     Global id of the entity.
+    bool IsImpeded(const FGuid& EntityId) const
+    {
+        return ImpededHoldRemaining.Contains(EntityId);
+    }
+
+    /// @brief Returns the number of entities currently impeded.
+    int32 GetNumImpeded() const
+    {
+        return ImpededHoldRemaining.Num();
+    }
+
+    /// @brief Rebuilds the grid, tests every line of fire, ages the hold of the entities no line
+    /// crossed and updates the impeding components.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed time in seconds, subtracted from the remaining holds.
+    virtual void Tick(float DeltaTime) override;
+
+    /// @brief Returns the stat id used to profile this subsystem.
+    virtual TStatId GetStatId() const override;
+
+private:
+    /// @brief Adds the capsule of every entity with a `FFriendlyFireImpedingMovementComponent`.
+    void GatherFriendlies();
+
+    /// @brief Refreshes the hold of the entities crossed this frame, expires the others and
+    /// writes the impeding components of the entities whose state changed.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed time in seconds.
+    void PublishResults(float DeltaTime);
+
+    /// @brief Grid and kernel. Reused every frame.
+    FLineOfFireChecker Checker;
+
+    /// @brief Guards `FrameLines`.
+    FCriticalSection LinesLock;
+
+    /// @brief Lines of fire registered since the last frame.
+    TArray<FLineOfFire> FrameLines;
+
+    /// @brief Output of the kernel, indexed like `Checker`.
+    TBitArray<> ImpededBits;
+
+    /// @brief Impeded entities and the time left before they are released, in seconds.
+    TMap<FGuid, float> ImpededHoldRemaining;
+};
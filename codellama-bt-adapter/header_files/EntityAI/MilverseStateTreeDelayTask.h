@@ -20,6 +20,8 @@
 
 #include "AI/MilVerseStateTreeTask.h"
 #include "CoreMinimal.h"
+#include "EntityAI/RandomStreamComponent.h"
+#include "EntityAI/TaskTimerWheel.h"
 #include "SimTimer.h"
 #include "MilverseStateTreeDelayTask.generated.h"
 
@@ -35,6 +37,8 @@ struct SIMULATIONBEHAVIORS_API FMilverseStateTreeDelayTaskInstanceData
     float Duration = 1.f;
 
     /// @brief Adds random range in seconds (+/- this value) to the Duration.
+    ///
+    /// Drawn from the entity's `FRandomStreamComponent` when present so runs are reproducible.
     UPROPERTY(EditAnywhere,
         Category = Parameter,
         meta = (EditCondition = "!bRunForever", ClampMin = "0.0"))
@@ -44,10 +48,15 @@ struct SIMULATIONBEHAVIORS_API FMilverseStateTreeDelayTaskInstanceData
     UPROPERTY(EditAnywhere, Category = Parameter)
     bool bRunForever = false;
 
-    /// @brief Remaining time before the end of the task. Internal countdown in seconds.
+    /// @brief Remaining time before the end of the task in seconds.
+    ///
+    /// Read back from the task timer whenever the task is ticked; it is not decremented per frame.
     UPROPERTY(EditAnywhere, Category = Output)
     float RemainingTime = 0.f;
 
+    /// @brief Expiry registered with `UTaskTimerSubsystem`. Not valid when `bRunForever` is set.
+    FTaskTimerHandle TimerHandle;
+
     /// @brief Used to track time between frames for a system.
     SimTimer SimClock;
 };
@@ -57,6 +66,10 @@ struct SIMULATIONBEHAVIORS_API FMilverseStateTreeDelayTaskInstanceData
 /// Returns Running while waiting.
 /// Returns Succeeded when the time to wait has elapsed.
 ///
+/// The task does not tick while waiting. Its expiry is registered with `UTaskTimerSubsystem` on
+/// enter and the task is woken by the `TaskTimerExpiredEvent` whose payload matches `TimerHandle`
+/// when it elapses.
+///
 USTRUCT(meta = (MilVerseGenericLevel))
 struct SIMULATIONBEHAVIORS_API FMilverseStateTreeDelayTask : public FMilVerseStateTreeTask
 {
@@ -68,6 +81,15 @@ struct SIMULATIONBEHAVIORS_API FMilverseStateTreeDelayTask : public FMilVerseSta
     FMilverseStateTreeDelayTask();
 
 protected:
+    /// @brief Called when the state tree asset is linked with data to allow the task to resolve
+    /// references to other state tree data.
+    ///
+    /// @param Linker
+    ///     Reference to the state tree's linker.
+    /// @returns
+    ///     Returns `true` if linking is successful; Otherwise returns `false`.
+    virtual bool Link(FStateTreeLinker& Linker) override;
+
     /// @brief Returns the struct definition for this nodes's instance data.
     virtual const UStruct* GetInstanceDataType() const override
     {
@@ -111,4 +133,8 @@ protected:
     ///     * EStateTreeRunStatus::Succeeded remaining time is <= 0
     virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context,
         const float DeltaTime) const override;
+
+protected:
+    /// @brief Optional handle for the `FRandomStreamComponent` ECS component.
+    TOptionalStateTreeExternalDataHandle<FRandomStreamComponent> RandomStreamHandle;
 };
@@ -19,6 +19,8 @@
 
 // MilVerse
 #include "EntityAI/MoveTask.h"
+#include "EntityAI/RandomStreamComponent.h"
+#include "EntityAI/TaskTimerWheel.h"
 #include "SimTimer.h"
 
 // Unreal Engine
@@ -41,13 +43,20 @@ struct SIMULATIONBEHAVIORS_API FMoveForDurationTaskInstanceData : public FMoveTa
 
     /// @brief Adds random value in the range of +/- this
     /// value in seconds to the duration.
+    ///
+    /// Drawn from the entity's `FRandomStreamComponent` when present so runs are reproducible.
     UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = "0.0"))
     float RandomDeviation = 0.f;
 
     /// @brief The remaining time to move in seconds.
+    ///
+    /// Read back from the task timer whenever the task is ticked; it is not decremented per frame.
     UPROPERTY(EditAnywhere, Category = Output)
     float RemainingTime = 0.f;
 
+    /// @brief Expiry of the move registered with `UTaskTimerSubsystem`.
+    FTaskTimerHandle TimerHandle;
+
     /// @brief Used to track time between frames for a system.
     SimTimer SimClock;
 };
@@ -131,4 +140,8 @@ protected:
     ///       move along the route.
     virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context,
         const float DeltaTime) const override;
+
+protected:
+    /// @brief Optional handle for the `FRandomStreamComponent` ECS component.
+    TOptionalStateTreeExternalDataHandle<FRandomStreamComponent> RandomStreamHandle;
 };
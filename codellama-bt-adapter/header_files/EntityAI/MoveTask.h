@@ -21,6 +21,7 @@
 #include "AI/MilVerseStateTreeTask.h"
 #include "Components/EntityStateComponent.h"
 #include "Components/MoveToComponent.h"
+#include "Components/UnitIdentifierComponent.h"
 #include "EntityAI/MoveTaskDataComponent.h"
 #include "SimTimer.h"
 
@@ -61,8 +62,13 @@ struct SIMULATIONBEHAVIORS_API FMoveTaskInstanceData
 
     UPROPERTY(EditAnywhere, Category = Parameter)
     /// @brief Flag to determine whether we should halt movement.
+    ///
+    /// Movement is also halted while the entity's unit is halted in `UUnitHaltSubsystem`.
     bool bIsHalted = false;
 
+    /// @brief Serial of the last unit halt for which zero velocity was reported.
+    uint32 ReportedHaltSerial = 0;
+
     /// @brief Clock used to track time between frames.
     SimTimer SimClock;
 };
@@ -163,6 +169,10 @@ protected:
     /// @brief Handle for the `FEntityStateComponent` ECS component.
     TStateTreeExternalDataHandle<FEntityStateComponent> EntityStateHandle;
 
+    /// @brief Optional handle for the `FUnitIdentifierComponent` ECS component. Used to look up
+    /// the unit-wide halt bit.
+    TOptionalStateTreeExternalDataHandle<FUnitIdentifierComponent> UnitIdentifierHandle;
+
 private:
     /// @brief Adjusts the follower speed in order to maintain the formation.
     ///
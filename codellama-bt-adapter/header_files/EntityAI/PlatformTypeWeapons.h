@@ -0,0 +1,46 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the FPlatformTypeWeapons struct.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "CommonAI/CommonTypes.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "PlatformTypeWeapons.generated.h"
+
+/// @brief Contains all the weapons that can be used to fire at the specific
+/// platform type
+///
+/// @sa FPlatformWeaponCompatibilityMatrix
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+USTRUCT(BlueprintType)
+struct FPlatformTypeWeapons
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Parameter")
+    /// @brief The platform type (e.g. Vehicle, Person, etc.)
+    PlatformTypes PlatformType = PlatformTypes::Vehicle;
+
+    UPROPERTY(EditAnywhere, Category = "Parameter")
+    /// @brief The weapon template names that can be used to fire at the platform type
+    TArray<FName> CompatibleWeapons;
+};
@@ -0,0 +1,111 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the FPlatformWeaponCompatibilityMatrix.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "CommonAI/CommonTypes.h"
+#include "EntityAI/PlatformTypeWeapons.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+
+//--------------------------------------------------------------------------------------------------
+
+class UWeaponTemplateRegistry;
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Bit matrix of which weapon templates can engage which platform types.
+///
+/// Compiled once from a list of @ref FPlatformTypeWeapons, replacing the per-threat walk over
+/// `CompatibleWeapons` with FName compares. Bit `(PlatformType, TemplateIndex)` is set when the
+/// template at `TemplateIndex` in @ref UWeaponTemplateRegistry can fire at the platform type.
+///
+/// Callers normally fold the templates an entity or unit carries into a platform mask with
+/// `GetEngageablePlatformMask` whenever the loadout changes, so that the per-threat check is a
+/// single bit test with `IsPlatformInMask`.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct SIMULATIONBEHAVIORS_API FPlatformWeaponCompatibilityMatrix
+{
+    /// @brief Builds the matrix. Templates unknown to the registry are ignored.
+    ///
+    /// @param PlatformTypeWeapons
+    ///     The weapons that can fire at each platform type.
+    /// @param Registry
+    ///     The registry providing the weapon template indices.
+    void Compile(TConstArrayView<FPlatformTypeWeapons> PlatformTypeWeapons,
+        const UWeaponTemplateRegistry& Registry);
+
+    /// @brief Returns `true` once `Compile` has been called, even if the registry was empty.
+    bool IsCompiled() const
+    {
+        return bCompiled;
+    }
+
+    /// @brief Returns `true` if the template can engage the platform type.
+    bool CanEngage(const PlatformTypes PlatformType, const int32 TemplateIndex) const
+    {
+        const int32 Bit = static_cast<int32>(PlatformType) * NumTemplates + TemplateIndex;
+        return TemplateIndex >= 0 && TemplateIndex < NumTemplates && Bits.IsValidIndex(Bit)
+            && Bits[Bit];
+    }
+
+    /// @brief Returns the platform types engageable by any of the given templates.
+    ///
+    /// @param TemplateIndices
+    ///     Registry indices of the templates carried.
+    /// @returns
+    ///     Mask with bit `1 << PlatformType` set for every engageable platform type.
+    uint32 GetEngageablePlatformMask(TConstArrayView<int32> TemplateIndices) const
+    {
+        uint32 Mask = 0;
+        for (int32 Platform = 0; Platform < NumPlatformTypes; ++Platform)
+        {
+            for (const int32 TemplateIndex : TemplateIndices)
+            {
+                if (CanEngage(static_cast<PlatformTypes>(Platform), TemplateIndex))
+                {
+                    Mask |= 1u << Platform;
+                    break;
+                }
+            }
+        }
+        return Mask;
+    }
+
+    /// @brief Returns `true` if the platform type is set in a mask from `GetEngageablePlatformMask`.
+    static bool IsPlatformInMask(const uint32 Mask, const PlatformTypes PlatformType)
+    {
+        return (Mask & (1u << static_cast<uint32>(PlatformType))) != 0;
+    }
+
+private:
+    /// @brief Row-major bits, one row of `NumTemplates` bits per platform type.
+    TBitArray<> Bits;
+
+    /// @brief Number of platform type rows.
+    int32 NumPlatformTypes = 0;
+
+    /// @brief Number of template columns.
+    int32 NumTemplates = 0;
+
+    /// @brief Set by `Compile`.
+    bool bCompiled = false;
+};
@@ -0,0 +1,115 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the FRandomStreamComponent.
+//--|
+//--|====================================================================|--
+#pragma once
+
+#include "ECS/SimComponent.h"
+
+#include "CoreMinimal.h"
+#include "RandomStreamComponent.generated.h"
+
+/// @brief Per-entity, counter-based random number stream for state tree nodes.
+///
+/// Every value is computed as `SplitMix64(Seed + Counter * Gamma)`, so the n-th draw of an entity
+/// depends only on the replication seed, the entity's global id and n. Nothing is shared between
+/// entities, which means no lock is needed while trees are ticked in parallel and a replication
+/// produces bitwise identical draws regardless of thread count or tick order between entities.
+///
+/// Tasks that need random values (e.g. `FMilverseStateTreeDelayTask::RandomDeviation`) access
+/// this component through an optional external data handle and fall back to `FMath` when it is
+/// not present on the entity.
+///
+/// @sa FMilverseStateTreeDelayTask
+/// @sa FMoveForDurationTask
+/// @sa FSelectWeaponAndFiringModeTask
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+USTRUCT()
+struct SIMULATIONBEHAVIORS_API FRandomStreamComponent : public FSimComponent
+{
+    GENERATED_BODY()
+
+    /// @brief Weyl sequence increment used to advance the counter (golden ratio in 64 bits).
+    static constexpr uint64 Gamma = 0x9E3779B97F4A7C15ull;
+
+    /// @brief Stream key. Derived from the replication seed and the entity id with `MakeSeed`.
+    UPROPERTY()
+    uint64 Seed = 0;
+
+    /// @brief Number of values drawn from the stream so far.
+    UPROPERTY()
+    uint64 Counter = 0;
+
+    /// @brief Initializes the stream for an entity of a given replication.
+    ///
+    /// @param ReplicationSeed
+    ///     Seed of the Monte Carlo replication being run.
+    /// @param GlobalEntityId
+    ///     Global id of the entity owning this stream.
+    void Reset(const uint64 ReplicationSeed, const FGuid& GlobalEntityId)
+    {
+        Seed = MakeSeed(ReplicationSeed, GlobalEntityId);
+        Counter = 0;
+    }
+
+    /// @brief Returns the next 64 random bits and advances the stream.
+    uint64 NextUInt64()
+    {
+        return Mix(Seed + (++Counter) * Gamma);
+    }
+
+    /// @brief Returns a uniformly distributed value in the range [0, 1).
+    float NextFraction()
+    {
+        // The top 24 bits fill the float mantissa exactly, so the result is never 1.
+        return static_cast<float>(NextUInt64() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    /// @brief Returns a uniformly distributed value in the range [Min, Max).
+    float RandRange(const float Min, const float Max)
+    {
+        return Min + (Max - Min) * NextFraction();
+    }
+
+    /// @brief Returns `Value` offset by a uniformly distributed amount in [-Deviation, Deviation).
+    ///
+    /// Always consumes exactly one draw, even when `Deviation` is zero, so that enabling or
+    /// disabling a deviation on one task does not shift the draws seen by later tasks.
+    float Deviate(const float Value, const float Deviation)
+    {
+        const float Offset = (2.f * NextFraction() - 1.f) * Deviation;
+        return Deviation > 0.f ? Value + Offset : Value;
+    }
+
+    /// @brief Derives a stream seed from a replication seed and an entity id.
+    static uint64 MakeSeed(const uint64 ReplicationSeed, const FGuid& GlobalEntityId)
+    {
+        uint64 Key = Mix(ReplicationSeed);
+        Key = Mix(Key ^ ((static_cast<uint64>(GlobalEntityId.A) << 32) | GlobalEntityId.B));
+        Key = Mix(Key ^ ((static_cast<uint64>(GlobalEntityId.C) << 32) | GlobalEntityId.D));
+        return Key;
+    }
+
+    /// @brief SplitMix64 finalizer.
+    static constexpr uint64 Mix(uint64 Value)
+    {
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+};
@@ -0,0 +1,79 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the RulesOfEngagementChangedEvent class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MILVERSE
+#include "AI/MilVerseStateTreeEvent.h"
+#include "Components/Engagement/RulesOfEngagementComponent.h"
+
+// UNREAL ENGINE
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+#include "RulesOfEngagementChangedEvent.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_MILVERSE_RULES_OF_ENGAGEMENT_CHANGED_EVENT)
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief State tree event payload for @ref RulesOfEngagementChangedEvent.
+///
+/// @ingroup SimulationBehaviors-Module
+USTRUCT()
+struct FRulesOfEngagementChangedEventPayload
+{
+    GENERATED_BODY()
+
+    /// @brief The ROE before the change.
+    UPROPERTY()
+    ERulesOfEngagementTypes PreviousROE = ERulesOfEngagementTypes::NONE;
+
+    /// @brief The ROE after the change.
+    UPROPERTY()
+    ERulesOfEngagementTypes NewROE = ERulesOfEngagementTypes::NONE;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Event emitted by @ref UUnitRulesOfEngagementSubsystem to the members of a unit whose
+/// rules of engagement changed.
+///
+/// Only changes of the unit's published ROE are reported. Changes of an entity's own
+/// `FRulesOfEngagementComponent` do not raise this event.
+///
+/// @ingroup SimulationBehaviors-Module
+class SIMULATIONBEHAVIORS_API RulesOfEngagementChangedEvent
+    : public MilVerseStateTreeEvent<RulesOfEngagementChangedEvent>
+{
+    MILVERSE_LOCAL_SIM_EVENT(RulesOfEngagementChangedEvent)
+
+public:
+    /// @brief The ROE before the change.
+    ERulesOfEngagementTypes PreviousROE = ERulesOfEngagementTypes::NONE;
+
+    /// @brief The ROE after the change.
+    ERulesOfEngagementTypes NewROE = ERulesOfEngagementTypes::NONE;
+
+public:
+    /// @brief Returns the gameplay tag associated with the state tree event.
+    FGameplayTag GetGameplayTag() const override;
+
+    /// @brief Returns the payload to include in the state tree event.
+    FInstancedStruct GetPayload() const override;
+};
@@ -25,6 +25,7 @@
 #include "Components/Engagement/TargetComponent.h"
 #include "Components/EntityStateComponent.h"
 #include "Components/Sensing/SensedEntitiesComponent.h"
+#include "EntityAI/TargetScoringKernel.h"
 
 // Unreal
 #include "CoreMinimal.h"
@@ -41,10 +42,16 @@ struct SIMULATIONBEHAVIORS_API FSelectClosestTargetTaskInstanceData
     UPROPERTY(EditAnywhere, Category = "Input")
     /// @brief An array of potential targets
     FEnemySituation EnemySituation;
+
+    /// @brief Candidate buffers, reused between selections.
+    FTargetScoringKernel TargetScoring;
 };
 
 /// @brief State tree task for performing suppression fire
 ///
+/// Uses the same `FTargetScoringKernel` as `FSelectTargetTask`, with weights that only count
+/// distance, so the closest threat scores highest.
+///
 /// This task requires that the entity have the following components assigned:
 /// * `FSensedEntitiesComponent`
 /// * `FTargetComponent`
@@ -22,6 +22,7 @@
 #include "CommonAI/CommonTypes.h"
 #include "Components/Engagement/TargetComponent.h"
 #include "Components/UnitIdentifierComponent.h"
+#include "EntityAI/TargetScoringKernel.h"
 
 // Unreal
 #include "CoreMinimal.h"
@@ -47,10 +48,20 @@ struct SIMULATIONBEHAVIORS_API FSelectTargetTaskInstanceData
     /// @brief Only select a target if we have been assigned a target.
     UPROPERTY(EditAnywhere, Category = "Parameter")
     bool bCheckForAssignedTarget = false;
+
+    /// @brief How candidate threats are ranked.
+    UPROPERTY(EditAnywhere, Category = "Parameter")
+    FTargetScoringWeights ScoringWeights;
+
+    /// @brief Candidate buffers, reused between selections.
+    FTargetScoringKernel TargetScoring;
 };
 
 /// @brief State tree task for selecting a target to engage
 ///
+/// The threats of the enemy situation are packed into `FTargetScoringKernel` and ranked by
+/// `ScoringWeights` in a single pass; the assigned target receives `AssignedBonus`.
+///
 /// This task requires that the entity have the following components assigned:
 /// * `FTargetComponent`
 /// * `FUnitIdentifierComponent`
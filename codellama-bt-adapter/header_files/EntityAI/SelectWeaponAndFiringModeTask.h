@@ -27,6 +27,8 @@
 #include "Components/Weapons/WeaponEnumerations.h"
 
 #include "Config/WeaponFiringConfig.h"
+#include "EntityAI/RandomStreamComponent.h"
+#include "EntityAI/WeaponTemplateRegistry.h"
 
 // Unreal Engine
 #include "CoreMinimal.h"
@@ -53,6 +55,14 @@ struct SIMULATIONBEHAVIORS_API FSelectWeaponAndFiringModeTaskInstanceData
     /// exited. Avoids an extra component lookup.
     UPROPERTY()
     float TriggerHoldTime = 0.0f;
+
+    /// @brief Weapon whose template index is cached in `ActiveWeaponTemplateIndex`.
+    FGuid ActiveWeaponId;
+
+    /// @brief Index of the active weapon's template in `UWeaponTemplateRegistry`.
+    ///
+    /// Only resolved through the inventory when the active weapon changes.
+    int32 ActiveWeaponTemplateIndex = INDEX_NONE;
 };
 
 /// @brief State tree task for performing suppression fire
@@ -129,6 +139,9 @@ protected:
     TArray<EFiringModes> FiringModeTypes;
 
     /// @brief Minimum time between shots.
+    ///
+    /// The interval is drawn between `FireIntervalMin` and `FireIntervalMax` from the entity's
+    /// `FRandomStreamComponent` when present.
     UPROPERTY(EditAnywhere, Category = Parameter)
     float FireIntervalMin = 0.0f;
 
@@ -155,13 +168,24 @@ protected:
     /// @brief Handle for the `FInventoryEquippedWeaponsComponent` ECS component.
     TStateTreeExternalDataHandle<FInventoryEquippedWeaponsComponent> InventoryEquippedWeaponsHandle;
 
+    /// @brief Optional handle for the `FRandomStreamComponent` ECS component.
+    TOptionalStateTreeExternalDataHandle<FRandomStreamComponent> RandomStreamHandle;
+
 private:
     /// @brief Gets the available weapon modes from the active weapon.
     ///
+    /// The inventory is only consulted when `ActiveWeaponGlobalEntityId` differs from the weapon
+    /// cached in the instance data; otherwise the modes come straight from the registry table.
+    ///
     /// @param ActiveWeaponGlobalEntityId
     ///      GlobalEntityID of the Entity's active weapon
+    /// @param Registry
+    ///      The compiled weapon template registry.
+    /// @param InstanceData
+    ///      Instance data holding the cached weapon template index.
     /// @returns
-    ///      List of available firing modes. Data is pulled from the weapon configuration and should
-    ///      not be saved.
-    const TArray<FWeaponFiringMode>& GetWeaponModes(const FGuid& ActiveWeaponGlobalEntityId) const;
+    ///      List of available firing modes. Data is owned by the registry and should not be saved.
+    TConstArrayView<FWeaponFiringMode> GetWeaponModes(const FGuid& ActiveWeaponGlobalEntityId,
+        const UWeaponTemplateRegistry& Registry,
+        FInstanceDataType& InstanceData) const;
 };
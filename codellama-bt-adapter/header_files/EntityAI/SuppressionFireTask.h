@@ -24,6 +24,8 @@
 #include "Components/Engagement/SuppressionFireComponent.h"
 #include "Components/EntityStateComponent.h"
 #include "Components/InventoryComponent.h"
+#include "EntityAI/FireControlSubsystem.h"
+#include "EntityAI/TaskTimerWheel.h"
 #include "SimTimer.h"
 
 // Unreal Engine
@@ -46,8 +48,10 @@ struct SIMULATIONBEHAVIORS_API FSuppressionFireTaskInstanceData
     UPROPERTY(EditAnywhere, Category = Parameter, meta = (UIMin = 0.5, ClampMin = 0.5))
     float TimeToPerformTask = 2.0;
 
-    /// @brief The time remaining to perform the task.
-    float TaskTimeRemaining;
+    /// @brief Expiry of the suppression fire registered with `UTaskTimerSubsystem`.
+    ///
+    /// Replaces a per-tick countdown of the time remaining to perform the task.
+    FTaskTimerHandle TaskTimerHandle;
 
     /// @brief Used to track time between frames for a system.
     SimTimer SimClock;
@@ -61,7 +65,8 @@ struct SIMULATIONBEHAVIORS_API FSuppressionFireTaskInstanceData
 /// * FAimComponent
 ///
 /// The task performs suppression fire for a fixed duration. It finishes after the
-/// time has expired and the trigger is released.
+/// time has expired and the trigger is released. Shots are queued with
+/// @ref UFireControlSubsystem rather than fired directly.
 ///
 /// @ingroup SimulationBehaviors-Module
 USTRUCT(meta = (MilVerseEntityLevel))
@@ -0,0 +1,85 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the TaskTimerExpiredEvent class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MILVERSE
+#include "AI/MilVerseStateTreeEvent.h"
+#include "EntityAI/TaskTimerWheel.h"
+
+// UNREAL ENGINE
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+#include "TaskTimerExpiredEvent.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_MILVERSE_TASK_TIMER_EXPIRED_EVENT)
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief State tree event payload for @ref TaskTimerExpiredEvent.
+///
+/// Identifies the timer that expired, so that only the task or evaluator holding that timer
+/// reacts when an entity has several timers pending.
+///
+/// @ingroup SimulationBehaviors-Module
+USTRUCT()
+struct FTaskTimerExpiredEventPayload
+{
+    GENERATED_BODY()
+
+    /// @brief Storage index of the expired timer. See `FTaskTimerHandle::Index`.
+    UPROPERTY()
+    int32 TimerIndex = INDEX_NONE;
+
+    /// @brief Generation of the expired timer. See `FTaskTimerHandle::Generation`.
+    UPROPERTY()
+    uint32 TimerGeneration = 0;
+
+    /// @brief Returns `true` if this payload reports the expiry of the given timer.
+    bool Matches(const FTaskTimerHandle& Handle) const
+    {
+        return Handle.IsValid() && Handle == FTaskTimerHandle{TimerIndex, TimerGeneration};
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Event emitted by @ref UTaskTimerSubsystem when a timer registered by an entity expires.
+///
+/// Timed tasks that do not tick while waiting are woken by this event. The payload carries the
+/// handle of the expired timer; a task compares it with its own handle and ignores the expiries
+/// of timers held by other tasks of the same entity.
+///
+/// @ingroup SimulationBehaviors-Module
+class SIMULATIONBEHAVIORS_API TaskTimerExpiredEvent
+    : public MilVerseStateTreeEvent<TaskTimerExpiredEvent>
+{
+    MILVERSE_LOCAL_SIM_EVENT(TaskTimerExpiredEvent)
+
+public:
+    /// @brief Handle of the timer that expired.
+    FTaskTimerHandle Timer;
+
+public:
+    /// @brief Returns the gameplay tag associated with the state tree event.
+    FGameplayTag GetGameplayTag() const override;
+
+    /// @brief Returns the payload to include in the state tree event.
+    FInstancedStruct GetPayload() const override;
+};
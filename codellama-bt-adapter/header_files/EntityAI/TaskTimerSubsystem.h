@@ -0,0 +1,87 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UTaskTimerSubsystem class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "EntityAI/TaskTimerWheel.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TaskTimerSubsystem.generated.h"
+
+/// @brief Shared timer service for timed state tree tasks and evaluators.
+///
+/// Tasks register an expiry instead of decrementing a countdown in every `Tick`. Pending timers
+/// are held in a hierarchical timer wheel, so waiting timers cost nothing per frame. When a timer
+/// expires a @ref TaskTimerExpiredEvent carrying its handle is sent to the owning entity, which
+/// wakes the task holding that handle.
+///
+/// The wheel is advanced with simulation time at a fixed resolution of `TickSeconds`.
+///
+/// @sa TTaskTimerWheel
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UTaskTimerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Resolution of the timer wheel in seconds.
+    static constexpr float TickSeconds = 0.01f;
+
+    /// @brief Registers a timer for an entity.
+    ///
+    /// @param GlobalEntityId
+    ///     The entity notified when the timer expires.
+    /// @param DelaySeconds
+    ///     Time until the timer expires in seconds.
+    /// @returns
+    ///     Handle to the timer. Store it in the task's instance data.
+    FTaskTimerHandle Schedule(const FGuid& GlobalEntityId, const float DelaySeconds);
+
+    /// @brief Cancels a timer, typically from `ExitState`. Invalidates the handle.
+    void Cancel(FTaskTimerHandle& Handle);
+
+    /// @brief Returns `true` if the timer has not expired yet.
+    bool IsPending(const FTaskTimerHandle& Handle) const;
+
+    /// @brief Returns the time in seconds until the timer expires, or 0 if it is not pending.
+    float GetRemainingTime(const FTaskTimerHandle& Handle) const;
+
+    /// @brief Returns the number of timers waiting to expire.
+    int32 GetNumPending() const;
+
+    /// @brief Advances the timer wheel and notifies entities whose timers expired.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed simulation time in seconds.
+    virtual void Tick(float DeltaTime) override;
+
+    /// @brief Returns the stat id used to profile this subsystem.
+    virtual TStatId GetStatId() const override;
+
+private:
+    /// @brief Pending timers keyed by the owning entity's global id.
+    TTaskTimerWheel<FGuid> TimerWheel;
+
+    /// @brief Simulation time not yet consumed by the wheel, in seconds.
+    float AccumulatedTime = 0.f;
+};
@@ -0,0 +1,312 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the hierarchical timer wheel used by state tree task timers.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// Unreal Engine
+#include "CoreMinimal.h"
+
+/// @brief Handle to a timer registered with a `TTaskTimerWheel`.
+///
+/// Handles are generation checked, so a stale handle to a timer that already expired or was
+/// cancelled never refers to a timer that later reuses the same storage slot.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FTaskTimerHandle
+{
+    /// @brief Index of the timer in the wheel's storage.
+    int32 Index = INDEX_NONE;
+
+    /// @brief Generation of the storage slot when the timer was registered.
+    uint32 Generation = 0;
+
+    /// @brief Returns `true` if the handle was assigned by a wheel.
+    bool IsValid() const
+    {
+        return Index != INDEX_NONE;
+    }
+
+    /// @brief Clears the handle.
+    void Invalidate()
+    {
+        Index = INDEX_NONE;
+        Generation = 0;
+    }
+
+    /// @brief Returns `true` if both handles refer to the same timer.
+    bool operator==(const FTaskTimerHandle& Other) const
+    {
+        return Index == Other.Index && Generation == Other.Generation;
+    }
+};
+
+/// @brief Hierarchical timer wheel with O(1) schedule and cancel.
+///
+/// Time is quantized into ticks. The wheel has `NumLevels` levels of `NumSlots` slots; level `L`
+/// holds the timers expiring less than `NumSlots^(L + 1)` ticks from now, bucketed by bits
+/// `[8L, 8L + 8)` of their expiry tick. Each advance only touches the level 0 slot for the new
+/// tick, plus one higher level slot every `NumSlots^L` ticks whose timers are redistributed
+/// (cascaded) to lower levels. Timers that are waiting therefore cost nothing per tick.
+///
+/// With 4 levels of 256 slots the horizon is 2^32 ticks.
+///
+/// @tparam PayloadType
+///     Value reported back when a timer expires (e.g. the owning entity's id).
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+template <typename PayloadType>
+class TTaskTimerWheel
+{
+public:
+    /// @brief Number of bits of the expiry tick consumed by each level.
+    static constexpr int32 SlotBits = 8;
+
+    /// @brief Number of slots per level.
+    static constexpr int32 NumSlots = 1 << SlotBits;
+
+    /// @brief Number of levels in the wheel.
+    static constexpr int32 NumLevels = 4;
+
+    /// @brief Constructor.
+    TTaskTimerWheel()
+    {
+        for (int32 Level = 0; Level < NumLevels; ++Level)
+        {
+            for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+            {
+                Heads[Level][Slot] = INDEX_NONE;
+            }
+        }
+    }
+
+    /// @brief Returns the current tick of the wheel.
+    uint64 GetCurrentTick() const
+    {
+        return CurrentTick;
+    }
+
+    /// @brief Returns the number of timers waiting to expire.
+    int32 Num() const
+    {
+        return NumActive;
+    }
+
+    /// @brief Registers a timer.
+    ///
+    /// @param DelayTicks
+    ///     Number of ticks until the timer expires. Values below 1 expire on the next tick.
+    /// @param Payload
+    ///     Value reported when the timer expires.
+    /// @returns
+    ///     Handle to the timer.
+    FTaskTimerHandle Schedule(const uint64 DelayTicks, const PayloadType& Payload)
+    {
+        int32 Index = FreeHead;
+        if (Index != INDEX_NONE)
+        {
+            FreeHead = Nodes[Index].Next;
+        }
+        else
+        {
+            Index = Nodes.AddDefaulted();
+        }
+
+        FNode& Node = Nodes[Index];
+        Node.ExpiryTick = CurrentTick + FMath::Max<uint64>(DelayTicks, 1);
+        Node.Payload = Payload;
+        Node.bActive = true;
+        Link(Index);
+        ++NumActive;
+
+        return FTaskTimerHandle{Index, Node.Generation};
+    }
+
+    /// @brief Cancels a timer. Does nothing if the timer already expired or was cancelled.
+    ///
+    /// @param Handle
+    ///     The timer to cancel. Invalidated on return.
+    void Cancel(FTaskTimerHandle& Handle)
+    {
+        if (IsPending(Handle))
+        {
+            Unlink(Handle.Index);
+            Release(Handle.Index);
+        }
+        Handle.Invalidate();
+    }
+
+    /// @brief Returns `true` if the timer is still waiting to expire.
+    bool IsPending(const FTaskTimerHandle& Handle) const
+    {
+        return Nodes.IsValidIndex(Handle.Index) && Nodes[Handle.Index].bActive
+            && Nodes[Handle.Index].Generation == Handle.Generation;
+    }
+
+    /// @brief Returns the number of ticks until the timer expires, or 0 if it is not pending.
+    uint64 GetRemainingTicks(const FTaskTimerHandle& Handle) const
+    {
+        return IsPending(Handle) ? Nodes[Handle.Index].ExpiryTick - CurrentTick : 0;
+    }
+
+    /// @brief Advances the wheel, reporting every timer that expires along the way.
+    ///
+    /// @param NumTicks
+    ///     Number of ticks to advance.
+    /// @param OnExpired
+    ///     Called with the payload and handle of each expired timer, in expiry order. The handle
+    ///     is no longer pending but still identifies the timer that expired.
+    void Advance(const uint64 NumTicks,
+        TFunctionRef<void(const PayloadType&, const FTaskTimerHandle&)> OnExpired)
+    {
+        for (uint64 Step = 0; Step < NumTicks; ++Step)
+        {
+            ++CurrentTick;
+
+            // Cascade higher levels whenever all of the bits below them wrap to zero.
+            for (int32 Level = 1; Level < NumLevels; ++Level)
+            {
+                if (SlotIndex(CurrentTick, Level - 1) != 0)
+                {
+                    break;
+                }
+                Cascade(Level, SlotIndex(CurrentTick, Level));
+            }
+
+            int32& Head = Heads[0][SlotIndex(CurrentTick, 0)];
+            while (Head != INDEX_NONE)
+            {
+                const int32 Index = Head;
+                Unlink(Index);
+                const PayloadType Payload = Nodes[Index].Payload;
+                const FTaskTimerHandle Handle{Index, Nodes[Index].Generation};
+                Release(Index);
+                OnExpired(Payload, Handle);
+            }
+
+            if (NumActive == 0)
+            {
+                // Nothing to wake, skip straight to the end of the advance.
+                CurrentTick += NumTicks - Step - 1;
+                break;
+            }
+        }
+    }
+
+private:
+    /// @brief Storage for a single timer.
+    struct FNode
+    {
+        uint64 ExpiryTick = 0;
+        PayloadType Payload = PayloadType();
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+        uint32 Generation = 0;
+        uint8 Level = 0;
+        uint8 Slot = 0;
+        bool bActive = false;
+    };
+
+    /// @brief Returns the slot of `Tick` in the given level.
+    static int32 SlotIndex(const uint64 Tick, const int32 Level)
+    {
+        return static_cast<int32>((Tick >> (Level * SlotBits)) & (NumSlots - 1));
+    }
+
+    /// @brief Inserts a timer into the slot matching its expiry tick.
+    void Link(const int32 Index)
+    {
+        FNode& Node = Nodes[Index];
+        const uint64 Delta = Node.ExpiryTick - CurrentTick;
+
+        int32 Level = 0;
+        while (Level < NumLevels - 1 && Delta >= (uint64(1) << ((Level + 1) * SlotBits)))
+        {
+            ++Level;
+        }
+
+        Node.Level = static_cast<uint8>(Level);
+        Node.Slot = static_cast<uint8>(SlotIndex(Node.ExpiryTick, Level));
+        Node.Prev = INDEX_NONE;
+        Node.Next = Heads[Level][Node.Slot];
+        if (Node.Next != INDEX_NONE)
+        {
+            Nodes[Node.Next].Prev = Index;
+        }
+        Heads[Level][Node.Slot] = Index;
+    }
+
+    /// @brief Removes a timer from its slot.
+    void Unlink(const int32 Index)
+    {
+        FNode& Node = Nodes[Index];
+        if (Node.Prev != INDEX_NONE)
+        {
+            Nodes[Node.Prev].Next = Node.Next;
+        }
+        else
+        {
+            Heads[Node.Level][Node.Slot] = Node.Next;
+        }
+        if (Node.Next != INDEX_NONE)
+        {
+            Nodes[Node.Next].Prev = Node.Prev;
+        }
+        Node.Prev = INDEX_NONE;
+        Node.Next = INDEX_NONE;
+    }
+
+    /// @brief Returns a timer's storage to the free list.
+    void Release(const int32 Index)
+    {
+        FNode& Node = Nodes[Index];
+        Node.bActive = false;
+        ++Node.Generation;
+        Node.Next = FreeHead;
+        FreeHead = Index;
+        --NumActive;
+    }
+
+    /// @brief Redistributes the timers of a higher level slot to lower levels.
+    void Cascade(const int32 Level, const int32 Slot)
+    {
+        int32 Index = Heads[Level][Slot];
+        Heads[Level][Slot] = INDEX_NONE;
+        while (Index != INDEX_NONE)
+        {
+            const int32 Next = Nodes[Index].Next;
+            Link(Index);
+            Index = Next;
+        }
+    }
+
+    /// @brief Timer storage. Released entries are chained through `FNode::Next`.
+    TArray<FNode> Nodes;
+
+    /// @brief First timer of each slot, per level.
+    int32 Heads[NumLevels][NumSlots];
+
+    /// @brief First released entry in `Nodes`.
+    int32 FreeHead = INDEX_NONE;
+
+    /// @brief Number of pending timers.
+    int32 NumActive = 0;
+
+    /// @brief Current tick of the wheel.
+    uint64 CurrentTick = 0;
+};
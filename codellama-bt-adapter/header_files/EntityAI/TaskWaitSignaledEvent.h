@@ -0,0 +1,84 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the TaskWaitSignaledEvent class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MILVERSE
+#include "AI/MilVerseStateTreeEvent.h"
+#include "EntityAI/TaskWaitSubsystem.h"
+
+// UNREAL ENGINE
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+#include "TaskWaitSignaledEvent.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_MILVERSE_TASK_WAIT_SIGNALED_EVENT)
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief State tree event payload for @ref TaskWaitSignaledEvent.
+///
+/// Identifies the completion that woke the entity, so that only the task parked on it reacts when
+/// an entity has several waits parked.
+///
+/// @ingroup SimulationBehaviors-Module
+USTRUCT()
+struct FTaskWaitSignaledEventPayload
+{
+    GENERATED_BODY()
+
+    /// @brief Kind of the completion. See `FTaskWaitKey::Signal`.
+    UPROPERTY()
+    ETaskWaitSignal Signal = ETaskWaitSignal::ORDER_VALIDATED;
+
+    /// @brief Order, unit or entity the completion refers to. See `FTaskWaitKey::SubjectId`.
+    UPROPERTY()
+    FGuid SubjectId;
+
+    /// @brief Returns `true` if this payload reports the completion a task is waiting on.
+    bool Matches(const FTaskWaitKey& Key) const
+    {
+        return Key == FTaskWaitKey{Signal, SubjectId};
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Event emitted by @ref UTaskWaitSubsystem to wake an entity parked on a wait handle.
+///
+/// The payload carries the key of the completion; a task compares it with the key it parked on
+/// and ignores wakes meant for the other waits of the same entity.
+///
+/// @ingroup SimulationBehaviors-Module
+class SIMULATIONBEHAVIORS_API TaskWaitSignaledEvent
+    : public MilVerseStateTreeEvent<TaskWaitSignaledEvent>
+{
+    MILVERSE_LOCAL_SIM_EVENT(TaskWaitSignaledEvent)
+
+public:
+    /// @brief The completion that woke the entity.
+    FTaskWaitKey Key;
+
+public:
+    /// @brief Returns the gameplay tag associated with the state tree event.
+    FGameplayTag GetGameplayTag() const override;
+
+    /// @brief Returns the payload to include in the state tree event.
+    FInstancedStruct GetPayload() const override;
+};
@@ -0,0 +1,174 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UTaskWaitSubsystem class and its wait handles.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TaskWaitSubsystem.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief The external completions a state tree task can park on.
+UENUM()
+enum class ETaskWaitSignal : uint8
+{
+    ORDER_VALIDATED,        ///< @brief An order finished validation (successfully or not).
+    ORDER_COMPLETED,        ///< @brief An order completed or was cancelled.
+    ROUTE_COMPLETED,        ///< @brief A unit reached the end of its route.
+    ORIENTATION_COMPLETED,  ///< @brief An entity finished an orientation transition.
+    STANCE_COMPLETED        ///< @brief An entity finished a stance transition.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Identifies what a parked task is waiting on.
+///
+/// @ingroup SimulationBehaviors-Module
+struct FTaskWaitKey
+{
+    /// @brief The kind of completion being waited on.
+    ETaskWaitSignal Signal = ETaskWaitSignal::ORDER_VALIDATED;
+
+    /// @brief The order, unit or entity the completion refers to.
+    FGuid SubjectId;
+
+    bool operator==(const FTaskWaitKey& Other) const
+    {
+        return Signal == Other.Signal && SubjectId == Other.SubjectId;
+    }
+
+    friend uint32 GetTypeHash(const FTaskWaitKey& Key)
+    {
+        return HashCombine(::GetTypeHash(static_cast<uint8>(Key.Signal)), GetTypeHash(Key.SubjectId));
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Handle to a task parked with @ref UTaskWaitSubsystem.
+///
+/// @ingroup SimulationBehaviors-Module
+struct FTaskWaitHandle
+{
+    /// @brief Index of the waiter in the subsystem's storage.
+    int32 Index = INDEX_NONE;
+
+    /// @brief Generation of the storage slot when the task was parked.
+    uint32 Generation = 0;
+
+    /// @brief Returns `true` if the handle refers to a parked task.
+    bool IsValid() const
+    {
+        return Index != INDEX_NONE;
+    }
+
+    /// @brief Clears the handle.
+    void Invalidate()
+    {
+        Index = INDEX_NONE;
+        Generation = 0;
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Sleep/wake service for state tree tasks blocked on an external completion.
+///
+/// Instead of polling every tick, a task parks on a completion (order validated, route complete,
+/// transition finished), returns `Running` and stops ticking. Whoever produces the completion calls
+/// `Signal`; every entity parked on it receives a @ref TaskWaitSignaledEvent, which ticks its
+/// tree once so the task can read the result and advance.
+///
+/// A signal raised before the task parks is not remembered. Tasks must therefore check the
+/// condition once after `Park` returns and only go idle if it is still unmet.
+///
+/// `ORDER_VALIDATED` and `ORDER_COMPLETED` are produced inside `UOrderSubsystem`, which does not
+/// call `Signal`. Tasks parked on them are therefore woken every tick, as often as they polled
+/// before, so waiting on an order adds no latency. A wake is not proof of completion; tasks always
+/// re-check their condition when woken.
+///
+/// @ingroup SimulationBehaviors-Module
+UCLASS()
+class SIMULATIONBEHAVIORS_API UTaskWaitSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Returns `true` for the signals without a producer, whose waiters are woken every tick.
+    static constexpr bool IsPolledEveryTick(const ETaskWaitSignal Signal)
+    {
+        return Signal == ETaskWaitSignal::ORDER_VALIDATED
+            || Signal == ETaskWaitSignal::ORDER_COMPLETED;
+    }
+
+    /// @brief Parks an entity's task on a completion.
+    ///
+    /// @param WaiterEntityId
+    ///     Global id of the entity whose tree is woken when the completion is signalled.
+    /// @param Key
+    ///     The completion to wait for.
+    /// @returns
+    ///     Handle to the wait. Store it in the task's instance data.
+    FTaskWaitHandle Park(const FGuid& WaiterEntityId, const FTaskWaitKey& Key);
+
+    /// @brief Removes a wait, typically from `ExitState`. Invalidates the handle.
+    void Unpark(FTaskWaitHandle& Handle);
+
+    /// @brief Returns `true` once the completion the handle waits on has been signalled.
+    bool IsSignaled(const FTaskWaitHandle& Handle) const;
+
+    /// @brief Wakes every entity parked on a completion.
+    ///
+    /// Each woken entity receives a @ref TaskWaitSignaledEvent carrying `Key`.
+    ///
+    /// @param Key
+    ///     The completion that occurred.
+    void Signal(const FTaskWaitKey& Key);
+
+    /// @brief Returns the number of tasks currently parked.
+    int32 GetNumParked() const;
+
+    /// @brief Wakes the tasks parked on signals for which `IsPolledEveryTick` is `true`.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed simulation time in seconds.
+    virtual void Tick(float DeltaTime) override;
+
+    /// @brief Returns the stat id used to profile this subsystem.
+    virtual TStatId GetStatId() const override;
+
+private:
+    /// @brief Storage for a single parked task.
+    struct FWaiter
+    {
+        FGuid WaiterEntityId;
+        FTaskWaitKey Key;
+        uint32 Generation = 0;
+        bool bSignaled = false;
+    };
+
+    /// @brief Parked tasks. Unparked entries are reused.
+    TSparseArray<FWaiter> Waiters;
+
+    /// @brief Indices into `Waiters` of the tasks parked on each completion.
+    TMap<FTaskWaitKey, TArray<int32>> WaitersByKey;
+
+    /// @brief Generation counter for reused `Waiters` entries.
+    uint32 NextGeneration = 1;
+};
@@ -0,0 +1,206 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UThreatTrackSubsystem class and its fused threat tracks.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "CommonAI/CommonTypes.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ThreatTrackSubsystem.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Threat information fused from the sensing of one enemy by every observer of one side.
+///
+/// Holds the freshest sample of the enemy any observer of the side has reported, so it does not
+/// depend on which observer reported first. Priority depends on the observer's range to the enemy
+/// and on whether its weapons can engage the enemy's platform, so each evaluator scores it itself
+/// from the shared track.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FThreatTrack
+{
+    /// @brief Global id of the enemy entity.
+    FGuid EnemyId;
+
+    /// @brief Side the track belongs to.
+    int32 Side = 0;
+
+    /// @brief Last sensed position of the enemy, in Unreal world space.
+    FVector Position = FVector::ZeroVector;
+
+    /// @brief Platform type of the enemy.
+    PlatformTypes PlatformType = PlatformTypes::Vehicle;
+
+    /// @brief Simulation time at which the enemy was last sensed, in seconds.
+    double LastSensedTime = 0.0;
+
+    /// @brief Frame of `UThreatTrackSubsystem` during which the track was last fused.
+    uint64 LastUpdateFrame = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Key of a fused track: one per enemy per side.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FThreatTrackKey
+{
+    /// @brief Side the track belongs to.
+    int32 Side = 0;
+
+    /// @brief Global id of the enemy entity.
+    FGuid EnemyId;
+
+    bool operator==(const FThreatTrackKey& Other) const
+    {
+        return Side == Other.Side && EnemyId == Other.EnemyId;
+    }
+
+    friend uint32 GetTypeHash(const FThreatTrackKey& Key)
+    {
+        return HashCombine(::GetTypeHash(Key.Side), GetTypeHash(Key.EnemyId));
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Per-frame counters of @ref UThreatTrackSubsystem.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+USTRUCT()
+struct SIMULATIONBEHAVIORS_API FThreatTrackStats
+{
+    GENERATED_BODY()
+
+    /// @brief Samples derived from sensing during the last frame.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int32 DerivationsLastFrame = 0;
+
+    /// @brief Reads served from a track at least as fresh as the caller's sensing, i.e.
+    /// derivations saved, during the last frame.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int32 ReusesLastFrame = 0;
+
+    /// @brief Number of live tracks at the end of the last frame.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int32 NumTracks = 0;
+
+    /// @brief Derivations saved since the subsystem was created.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int64 TotalReuses = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Shared store of fused threat tracks.
+///
+/// The entity level `FEnemySituationEvaluator` and the unit level
+/// `FUnitEnemySituationEvaluator` both derive threat information from the same sensed entities.
+/// Each caller passes the time at which it last sensed the enemy. If the side's track is at least
+/// that fresh it is returned without deriving anything; otherwise the caller derives a sample from
+/// its own sensing and the sample replaces the track. The track therefore always holds the newest
+/// sample reported by any observer of the side. Threat priority is not shared: it is scored by
+/// each evaluator from the track.
+///
+/// Tracks that have not been fused for `StaleFrames` frames are dropped.
+///
+/// @sa FEnemySituationEvaluator
+/// @sa FUnitEnemySituationEvaluator
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UThreatTrackSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Number of frames without an update after which a track is dropped.
+    static constexpr uint64 StaleFrames = 300;
+
+    /// @brief Returns the fused track of an enemy, fusing the caller's sensing into it first if
+    /// the caller sensed the enemy more recently than the track. Safe to call from any thread.
+    ///
+    /// `Derive` runs outside the lock, so evaluators ticking in parallel only serialize on the
+    /// lookup and the insert. Two callers may derive the same enemy concurrently; the sample with
+    /// the newest `LastSensedTime` is kept.
+    ///
+    /// @param Side
+    ///     Side of the evaluating entity or unit.
+    /// @param EnemyId
+    ///     Global id of the enemy.
+    /// @param SensedTime
+    ///     Simulation time at which the caller last sensed the enemy, in seconds.
+    /// @param Derive
+    ///     Fills in a sample from the caller's sensing of the enemy, including `LastSensedTime`.
+    ///     Only called if the track is older than `SensedTime`. `EnemyId`, `Side` and
+    ///     `LastUpdateFrame` are set by the subsystem.
+    /// @returns
+    ///     A copy of the fused track.
+    FThreatTrack FindOrDerive(const int32 Side,
+        const FGuid& EnemyId,
+        const double SensedTime,
+        TFunctionRef<void(FThreatTrack&)> Derive);
+
+    /// @brief Returns the current frame of the store.
+    uint64 GetFrame() const
+    {
+        return Frame;
+    }
+
+    /// @brief Returns the counters of the last frame.
+    const FThreatTrackStats& GetStats() const
+    {
+        return Stats;
+    }
+
+    /// @brief Rolls the per-frame counters, drops stale tracks and advances the frame.
+    ///
+    /// @param DeltaTime
+    ///     Elapsed time in seconds. Not used.
+    virtual void Tick(float DeltaTime) override;
+
+    /// @brief Returns the stat id used to profile this subsystem.
+    virtual TStatId GetStatId() const override;
+
+private:
+    /// @brief Guards `Tracks` and the frame counters. Not held while a sample is derived.
+    FCriticalSection TracksLock;
+
+    /// @brief Fused tracks, one per enemy per side.
+    TMap<FThreatTrackKey, FThreatTrack> Tracks;
+
+    /// @brief Current frame. Starts at 1 so that a default track is never current.
+    uint64 Frame = 1;
+
+    /// @brief Samples derived during the current frame.
+    int32 FrameDerivations = 0;
+
+    /// @brief Reads served without deriving during the current frame.
+    int32 FrameReuses = 0;
+
+    /// @brief Counters of the last frame.
+    FThreatTrackStats Stats;
+};
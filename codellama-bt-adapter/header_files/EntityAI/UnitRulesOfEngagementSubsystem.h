@@ -0,0 +1,112 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UUnitRulesOfEngagementSubsystem class and ROE bitmask helpers.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "Components/Engagement/RulesOfEngagementComponent.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UnitRulesOfEngagementSubsystem.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Helpers to compile sets of rules of engagement into bitmasks.
+///
+/// Bit `N` of a mask is set when the ROE type with underlying value `N` is in the set, so
+/// testing whether a current ROE is part of a set is a single AND.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FRulesOfEngagementMask
+{
+    /// @brief Returns the mask holding a single ROE type.
+    static uint32 Make(const ERulesOfEngagementTypes ROE)
+    {
+        checkSlow(static_cast<uint32>(ROE) < 32);
+        return 1u << static_cast<uint32>(ROE);
+    }
+
+    /// @brief Returns the mask holding every ROE type of a set.
+    static uint32 Compile(TConstArrayView<ERulesOfEngagementTypes> ROEs)
+    {
+        uint32 Mask = 0;
+        for (const ERulesOfEngagementTypes ROE : ROEs)
+        {
+            Mask |= Make(ROE);
+        }
+        return Mask;
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Holds the current rules of engagement of every unit as a bitmask.
+///
+/// The order system publishes a unit's ROE here whenever an order sets it. When the ROE actually
+/// changes, a `RulesOfEngagementChangedEvent` is sent to the unit's members so that states
+/// depending on a `FRulesOfEngagementCondition` that tests the unit's ROE are only re-evaluated on
+/// a change, never because the same ROE was issued again.
+///
+/// The subsystem lives with the entity level code because `FRulesOfEngagementCondition` reads it;
+/// only the unit order system writes to it.
+///
+/// @sa FRulesOfEngagementCondition
+/// @sa RulesOfEngagementChangedEvent
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UUnitRulesOfEngagementSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Publishes the current ROE of a unit.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @param ROE
+    ///     The unit's ROE.
+    /// @returns
+    ///     `true` if the ROE changed and the unit's members were notified.
+    bool SetUnitROE(const FGuid& UnitId, const ERulesOfEngagementTypes ROE);
+
+    /// @brief Returns the current ROE mask of a unit, or 0 if none was published.
+    uint32 GetUnitROEMask(const FGuid& UnitId) const
+    {
+        const uint32* Mask = UnitROEMasks.Find(UnitId);
+        return Mask ? *Mask : 0;
+    }
+
+    /// @brief Removes a unit, e.g. when it is destroyed.
+    void RemoveUnit(const FGuid& UnitId)
+    {
+        UnitROEMasks.Remove(UnitId);
+    }
+
+private:
+    /// @brief Sends `RulesOfEngagementChangedEvent` to every member of a unit.
+    void NotifyMembers(const FGuid& UnitId,
+        const ERulesOfEngagementTypes PreviousROE,
+        const ERulesOfEngagementTypes NewROE) const;
+
+    /// @brief Current ROE mask per unit.
+    TMap<FGuid, uint32> UnitROEMasks;
+};
@@ -0,0 +1,111 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UWeaponTemplateRegistry class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "CommonAI/CommonTypes.h"
+#include "Config/WeaponFiringConfig.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "WeaponTemplateRegistry.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Compiled, read-only data for a single weapon template.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+struct FWeaponTemplateEntry
+{
+    /// @brief Name of the weapon template.
+    FName TemplateName;
+
+    /// @brief Index of the template's first firing mode in the registry's firing mode table.
+    int32 FirstFiringMode = 0;
+
+    /// @brief Number of firing modes of the template.
+    int32 NumFiringModes = 0;
+
+    /// @brief Maximum engagement distance of the template.
+    float MaxEngagementDistance = 0.f;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Registry of weapon templates compiled into flat tables when the game instance starts.
+///
+/// Resolving firing modes and ranges through the inventory components is done once per template
+/// at load instead of every time a weapon or mode is selected. Templates are addressed by a dense
+/// index, which nodes cache per weapon (see
+/// `FSelectWeaponAndFiringModeTaskInstanceData::ActiveWeaponTemplateIndex`). The tables are
+/// never modified after `Initialize`, so they can be read from parallel state tree ticks.
+///
+/// Platform compatibility is not stored here. It is authored per node in `FPlatformTypeWeapons`
+/// and compiled into an @ref FPlatformWeaponCompatibilityMatrix, the single source of truth for
+/// which template can engage which platform type.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup EntityAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UWeaponTemplateRegistry : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Compiles every weapon template from the weapon configuration.
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    /// @brief Returns the index of a weapon template, or `INDEX_NONE` if it is unknown.
+    int32 FindTemplateIndex(const FName TemplateName) const
+    {
+        const int32* Index = IndexByName.Find(TemplateName);
+        return Index != nullptr ? *Index : INDEX_NONE;
+    }
+
+    /// @brief Returns the number of compiled templates.
+    int32 GetNumTemplates() const
+    {
+        return Templates.Num();
+    }
+
+    /// @brief Returns a compiled template. `TemplateIndex` must be valid.
+    const FWeaponTemplateEntry& GetTemplate(const int32 TemplateIndex) const
+    {
+        return Templates[TemplateIndex];
+    }
+
+    /// @brief Returns the firing modes of a template. `TemplateIndex` must be valid.
+    TConstArrayView<FWeaponFiringMode> GetFiringModes(const int32 TemplateIndex) const
+    {
+        const FWeaponTemplateEntry& Entry = Templates[TemplateIndex];
+        return TConstArrayView<FWeaponFiringMode>(FiringModes.GetData() + Entry.FirstFiringMode,
+            Entry.NumFiringModes);
+    }
+
+private:
+    /// @brief Compiled templates, indexed by template index.
+    TArray<FWeaponTemplateEntry> Templates;
+
+    /// @brief Firing modes of all templates, stored contiguously per template.
+    TArray<FWeaponFiringMode> FiringModes;
+
+    /// @brief Template index by template name.
+    TMap<FName, int32> IndexByName;
+};
@@ -0,0 +1,299 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the FCombatPowerHierarchy incremental combat power aggregate.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "UnitAI/UnitHierarchy.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+
+/// @brief Friendly and perceived enemy combat power of every unit, maintained incrementally.
+///
+/// Each unit stores the combat power of its own members and of the contacts it perceives, plus
+/// the totals of its whole subtree (the unit and all its subunits, e.g. a company and its
+/// platoons). Every change (a member damaged, resupplied or destroyed, a contact appearing,
+/// changing or disappearing) is applied as a delta to the unit and to each of its ancestors, so
+/// it costs O(echelon depth) and reading any unit's totals is O(1). Nothing is ever recomputed
+/// from scratch.
+///
+/// Friendly power sums over members. Enemy power is the sum over distinct contacts: a contact
+/// perceived by two platoons of the same company counts once in the company's total. To that
+/// end each unit keeps a reference count per contact perceived anywhere in its subtree.
+///
+/// Totals are accumulated in double precision so that adding and later removing the same
+/// contributions returns them to zero instead of leaving a float residue. Whether a unit
+/// perceives any enemy is still decided from `GetNumContacts`, never from the enemy total.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup UnitAI
+class FCombatPowerHierarchy
+{
+public:
+    /// @brief Adds a unit. Parents must be added before their subunits.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @param ParentUnitId
+    ///     Global id of the parent unit, or an invalid id for a top level unit.
+    void AddUnit(const FGuid& UnitId, const FGuid& ParentUnitId)
+    {
+        bool bAdded = false;
+        Hierarchy.AddUnit(UnitId, ParentUnitId, bAdded);
+        if (bAdded)
+        {
+            Units.AddDefaulted();
+        }
+    }
+
+    /// @brief Sets the combat power of a member, adding the member if needed.
+    ///
+    /// @param UnitId
+    ///     Global id of the member's unit. Must have been added.
+    /// @param MemberId
+    ///     Global id of the member.
+    /// @param Power
+    ///     Current combat power of the member, e.g. after damage or resupply.
+    void SetMemberPower(const FGuid& UnitId, const FGuid& MemberId, const float Power)
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        if (UnitIndex == INDEX_NONE)
+        {
+            return;
+        }
+        FMember& Member = Members.FindOrAdd(MemberId, FMember{UnitIndex, 0.0});
+        if (Member.UnitIndex != UnitIndex)
+        {
+            // The member changed unit: move its whole contribution.
+            AddFriendly(Member.UnitIndex, -Member.Power);
+            Member.UnitIndex = UnitIndex;
+            Member.Power = 0.0;
+        }
+        AddFriendly(UnitIndex, Power - Member.Power);
+        Member.Power = Power;
+    }
+
+    /// @brief Removes a member, e.g. when it is destroyed.
+    void RemoveMember(const FGuid& MemberId)
+    {
+        FMember Member;
+        if (Members.RemoveAndCopyValue(MemberId, Member))
+        {
+            AddFriendly(Member.UnitIndex, -Member.Power);
+        }
+    }
+
+    /// @brief Sets the perceived combat power of a contact and records that a unit perceives it.
+    ///
+    /// @param UnitId
+    ///     Global id of the perceiving unit. Must have been added.
+    /// @param ContactId
+    ///     Global id of the enemy entity.
+    /// @param Power
+    ///     Perceived combat power of the contact. Shared by every unit perceiving it.
+    void SetContactPower(const FGuid& UnitId, const FGuid& ContactId, const float Power)
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        if (UnitIndex == INDEX_NONE)
+        {
+            return;
+        }
+
+        FContact& Contact = Contacts.FindOrAdd(ContactId);
+        if (Contact.Power != Power)
+        {
+            // Every unit counting the contact sees the change.
+            const double Delta = Power - Contact.Power;
+            for (const int32 HolderIndex : Contact.Holders)
+            {
+                Units[HolderIndex].EnemySubtree += Delta;
+            }
+            for (const int32 DirectIndex : Contact.Perceivers)
+            {
+                Units[DirectIndex].EnemyOwn += Delta;
+            }
+            Contact.Power = Power;
+        }
+
+        if (!Contact.Perceivers.Contains(UnitIndex))
+        {
+            Contact.Perceivers.Add(UnitIndex);
+            Units[UnitIndex].EnemyOwn += Power;
+            ++Units[UnitIndex].NumOwnContacts;
+            Hierarchy.ForEachAncestor(UnitIndex,
+                [this, &Contact, &ContactId, Power](const int32 Index)
+            {
+                int32& RefCount = Units[Index].ContactRefs.FindOrAdd(ContactId);
+                if (RefCount++ == 0)
+                {
+                    Units[Index].EnemySubtree += Power;
+                    Contact.Holders.Add(Index);
+                }
+            });
+        }
+    }
+
+    /// @brief Records that a unit no longer perceives a contact.
+    void RemoveContact(const FGuid& UnitId, const FGuid& ContactId)
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        if (UnitIndex != INDEX_NONE)
+        {
+            RemoveContactAt(UnitIndex, ContactId);
+        }
+    }
+
+    /// @brief Removes a contact from every unit, e.g. when it is destroyed.
+    void RemoveContactEverywhere(const FGuid& ContactId)
+    {
+        while (const FContact* Contact = Contacts.Find(ContactId))
+        {
+            RemoveContactAt(Contact->Perceivers.Last(), ContactId);
+        }
+    }
+
+    /// @brief Returns the friendly combat power of a unit.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @param bIncludeSubunits
+    ///     If `true`, includes every subunit down the hierarchy.
+    float GetFriendlyPower(const FGuid& UnitId, const bool bIncludeSubunits = true) const
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        return UnitIndex != INDEX_NONE
+            ? static_cast<float>(
+                bIncludeSubunits ? Units[UnitIndex].FriendlySubtree : Units[UnitIndex].FriendlyOwn)
+            : 0.f;
+    }
+
+    /// @brief Returns the combat power of the distinct contacts perceived by a unit.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @param bIncludeSubunits
+    ///     If `true`, includes the contacts perceived by every subunit down the hierarchy.
+    float GetEnemyPower(const FGuid& UnitId, const bool bIncludeSubunits = true) const
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        return UnitIndex != INDEX_NONE
+            ? static_cast<float>(
+                bIncludeSubunits ? Units[UnitIndex].EnemySubtree : Units[UnitIndex].EnemyOwn)
+            : 0.f;
+    }
+
+    /// @brief Returns the number of distinct contacts perceived by a unit.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @param bIncludeSubunits
+    ///     If `true`, includes the contacts perceived by every subunit down the hierarchy.
+    int32 GetNumContacts(const FGuid& UnitId, const bool bIncludeSubunits = true) const
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        return UnitIndex != INDEX_NONE
+            ? (bIncludeSubunits
+                ? Units[UnitIndex].ContactRefs.Num()
+                : Units[UnitIndex].NumOwnContacts)
+            : 0;
+    }
+
+private:
+    /// @brief Aggregates of a single unit.
+    struct FUnitNode
+    {
+        double FriendlyOwn = 0.0;
+        double FriendlySubtree = 0.0;
+        double EnemyOwn = 0.0;
+        double EnemySubtree = 0.0;
+
+        /// @brief Number of contacts perceived by the unit itself.
+        int32 NumOwnContacts = 0;
+
+        /// @brief Number of units of the subtree perceiving each contact.
+        TMap<FGuid, int32> ContactRefs;
+    };
+
+    /// @brief Contribution of a single member.
+    struct FMember
+    {
+        int32 UnitIndex = INDEX_NONE;
+        double Power = 0.0;
+    };
+
+    /// @brief A perceived contact.
+    struct FContact
+    {
+        double Power = 0.0;
+
+        /// @brief Units perceiving the contact directly.
+        TArray<int32, TInlineAllocator<4>> Perceivers;
+
+        /// @brief Units counting the contact in their subtree total.
+        TArray<int32, TInlineAllocator<8>> Holders;
+    };
+
+    /// @brief Applies a friendly power delta to a unit and its ancestors.
+    void AddFriendly(const int32 UnitIndex, const double Delta)
+    {
+        Units[UnitIndex].FriendlyOwn += Delta;
+        Hierarchy.ForEachAncestor(UnitIndex, [this, Delta](const int32 Index)
+        {
+            Units[Index].FriendlySubtree += Delta;
+        });
+    }
+
+    /// @brief Records that the unit at an index no longer perceives a contact.
+    void RemoveContactAt(const int32 UnitIndex, const FGuid& ContactId)
+    {
+        FContact* Contact = Contacts.Find(ContactId);
+        if (!Contact || Contact->Perceivers.RemoveSwap(UnitIndex) == 0)
+        {
+            return;
+        }
+
+        Units[UnitIndex].EnemyOwn -= Contact->Power;
+        --Units[UnitIndex].NumOwnContacts;
+        Hierarchy.ForEachAncestor(UnitIndex, [this, Contact, &ContactId](const int32 Index)
+        {
+            int32& RefCount = Units[Index].ContactRefs.FindChecked(ContactId);
+            if (--RefCount == 0)
+            {
+                Units[Index].ContactRefs.Remove(ContactId);
+                Units[Index].EnemySubtree -= Contact->Power;
+                Contact->Holders.RemoveSwap(Index);
+            }
+        });
+        if (Contact->Perceivers.IsEmpty())
+        {
+            Contacts.Remove(ContactId);
+        }
+    }
+
+    /// @brief Unit indices and parent links.
+    FUnitHierarchy Hierarchy;
+
+    /// @brief Unit aggregates, indexed like `Hierarchy`.
+    TArray<FUnitNode> Units;
+
+    /// @brief Contribution of each member.
+    TMap<FGuid, FMember> Members;
+
+    /// @brief Perceived contacts.
+    TMap<FGuid, FContact> Contacts;
+};
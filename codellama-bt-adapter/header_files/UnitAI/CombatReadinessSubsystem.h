@@ -0,0 +1,215 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UCombatReadinessSubsystem class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "UnitAI/UnitHierarchy.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatReadinessSubsystem.generated.h"
+
+/// @brief Combat readiness of every entity and unit, maintained on change.
+///
+/// An entity's readiness is the lowest of its health, ammunition and fuel fractions, as a
+/// percentage: an entity is only as ready as its most depleted resource. The health, inventory
+/// and fuel systems report changes with `UpdateEntity`; the new readiness is written to the
+/// entity's `FCombatReadinessComponent` and applied as a delta to its unit and every ancestor
+/// unit, which keep the sum of their members' readiness and their member count. A unit's
+/// readiness is the mean over all members of its subtree, so reading it is O(1) at any echelon.
+/// Sums are kept in double precision so that members leaving a unit do not leave a residue.
+/// Units and their parent links are held by the same `FUnitHierarchy` helper as
+/// `FCombatPowerHierarchy` uses.
+///
+/// Order tasks use `GetSubunitsAtOrAbove` to find in one call which subunits are ready enough
+/// to commit.
+///
+/// @sa FCombatReadinessCondition
+/// @sa FIssueAttackOrdersTask
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup UnitAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UCombatReadinessSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Adds a unit. Parents must be added before their subunits.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @param ParentUnitId
+    ///     Global id of the parent unit, or an invalid id for a top level unit.
+    void AddUnit(const FGuid& UnitId, const FGuid& ParentUnitId)
+    {
+        bool bAdded = false;
+        Hierarchy.AddUnit(UnitId, ParentUnitId, bAdded);
+        if (bAdded)
+        {
+            ReadinessSums.Add(0.0);
+            MemberCounts.Add(0);
+        }
+    }
+
+    /// @brief Updates the readiness of an entity, adding it to its unit if needed.
+    ///
+    /// @param UnitId
+    ///     Global id of the entity's unit. Must have been added.
+    /// @param EntityId
+    ///     Global id of the entity.
+    /// @param HealthFraction
+    ///     Remaining health, in [0, 1].
+    /// @param AmmoFraction
+    ///     Remaining ammunition, in [0, 1].
+    /// @param FuelFraction
+    ///     Remaining fuel, in [0, 1]. Pass 1 for entities that do not use fuel.
+    /// @returns
+    ///     The entity's readiness, in percent.
+    float UpdateEntity(const FGuid& UnitId,
+        const FGuid& EntityId,
+        const float HealthFraction,
+        const float AmmoFraction,
+        const float FuelFraction)
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        if (UnitIndex == INDEX_NONE)
+        {
+            return 0.f;
+        }
+
+        const float Readiness =
+            100.f * FMath::Clamp(FMath::Min3(HealthFraction, AmmoFraction, FuelFraction), 0.f, 1.f);
+
+        FEntityReadiness* Entity = Entities.Find(EntityId);
+        if (!Entity)
+        {
+            Entity = &Entities.Add(EntityId, FEntityReadiness{UnitIndex, 0.f});
+            ApplyDelta(UnitIndex, 0.0, 1);
+        }
+        else if (Entity->UnitIndex != UnitIndex)
+        {
+            ApplyDelta(Entity->UnitIndex, -Entity->ReadinessPercent, -1);
+            ApplyDelta(UnitIndex, Entity->ReadinessPercent, 1);
+            Entity->UnitIndex = UnitIndex;
+        }
+
+        ApplyDelta(UnitIndex, static_cast<double>(Readiness) - Entity->ReadinessPercent, 0);
+        Entity->ReadinessPercent = Readiness;
+        return Readiness;
+    }
+
+    /// @brief Removes an entity, e.g. when it is destroyed.
+    void RemoveEntity(const FGuid& EntityId)
+    {
+        FEntityReadiness Entity;
+        if (Entities.RemoveAndCopyValue(EntityId, Entity))
+        {
+            ApplyDelta(Entity.UnitIndex, -Entity.ReadinessPercent, -1);
+        }
+    }
+
+    /// @brief Returns the readiness of an entity in percent, or 0 if it is unknown.
+    float GetEntityReadinessPercent(const FGuid& EntityId) const
+    {
+        const FEntityReadiness* Entity = Entities.Find(EntityId);
+        return Entity ? Entity->ReadinessPercent : 0.f;
+    }
+
+    /// @brief Returns the mean readiness of a unit's members, subunits included, in percent.
+    float GetUnitReadinessPercent(const FGuid& UnitId) const
+    {
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        return UnitIndex != INDEX_NONE ? GetUnitReadinessPercent(UnitIndex) : 0.f;
+    }
+
+    /// @brief Finds the direct subunits of a unit whose readiness is at least a threshold.
+    ///
+    /// @param UnitId
+    ///     Global id of the parent unit.
+    /// @param MinimumReadinessPercent
+    ///     Readiness threshold, in percent.
+    /// @param OutSubunitIds
+    ///     Assigned the qualifying subunits, most ready first.
+    void GetSubunitsAtOrAbove(const FGuid& UnitId,
+        const float MinimumReadinessPercent,
+        TArray<FGuid>& OutSubunitIds) const
+    {
+        OutSubunitIds.Reset();
+        const int32 UnitIndex = Hierarchy.Find(UnitId);
+        if (UnitIndex == INDEX_NONE)
+        {
+            return;
+        }
+
+        TArray<TPair<float, int32>, TInlineAllocator<16>> Qualifying;
+        for (const int32 ChildIndex : Hierarchy.GetChildren(UnitIndex))
+        {
+            const float Readiness = GetUnitReadinessPercent(ChildIndex);
+            if (MemberCounts[ChildIndex] > 0 && Readiness >= MinimumReadinessPercent)
+            {
+                Qualifying.Emplace(Readiness, ChildIndex);
+            }
+        }
+        Qualifying.Sort([](const TPair<float, int32>& Lhs, const TPair<float, int32>& Rhs)
+            { return Lhs.Key > Rhs.Key; });
+
+        OutSubunitIds.Reserve(Qualifying.Num());
+        for (const TPair<float, int32>& Pair : Qualifying)
+        {
+            OutSubunitIds.Add(Hierarchy.GetUnitId(Pair.Value));
+        }
+    }
+
+private:
+    /// @brief Readiness of a single entity.
+    struct FEntityReadiness
+    {
+        int32 UnitIndex = INDEX_NONE;
+        float ReadinessPercent = 0.f;
+    };
+
+    /// @brief Returns the mean readiness of the unit at an index, in percent.
+    float GetUnitReadinessPercent(const int32 UnitIndex) const
+    {
+        return MemberCounts[UnitIndex] > 0
+            ? static_cast<float>(ReadinessSums[UnitIndex] / MemberCounts[UnitIndex])
+            : 0.f;
+    }
+
+    /// @brief Applies a readiness and member count delta to a unit and its ancestors.
+    void ApplyDelta(const int32 UnitIndex, const double ReadinessDelta, const int32 MemberDelta)
+    {
+        Hierarchy.ForEachAncestor(UnitIndex, [this, ReadinessDelta, MemberDelta](const int32 Index)
+        {
+            ReadinessSums[Index] += ReadinessDelta;
+            MemberCounts[Index] += MemberDelta;
+        });
+    }
+
+    /// @brief Unit indices and parent/child links.
+    FUnitHierarchy Hierarchy;
+
+    /// @brief Per-unit sums, indexed like `Hierarchy`.
+    TArray<double> ReadinessSums;
+    TArray<int32> MemberCounts;
+
+    /// @brief Readiness of each entity.
+    TMap<FGuid, FEntityReadiness> Entities;
+};
@@ -24,6 +24,8 @@
 #include "Components/Units/SegmentedRouteComponent.h"
 #include "Components/Units/UnitFormationComponent.h"
 #include "Routes/RoutePoint.h"
+#include "UnitAI/CombatReadinessSubsystem.h"
+#include "EntityAI/TaskWaitSubsystem.h"
 // Unreal Engine
 #include "CoreMinimal.h"
 #include "IssueAttackOrdersTask.generated.h"
@@ -74,9 +76,22 @@ struct SIMULATIONBEHAVIORS_API FIssueAttackOrdersTaskInstanceData
     UPROPERTY(VisibleAnywhere, Category = Input)
     bool bShouldSkipFormup = true;
 
+    /// @brief Subunits below this combat readiness, in percent, are not committed to the attack.
+    ///
+    /// Resolved with a single `UCombatReadinessSubsystem::GetSubunitsAtOrAbove` query.
+    UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = "0.0", ClampMax = "100.0"))
+    float MinimumSubunitReadinessPercent = 0.0f;
+
     /// @brief The current stage of this task.
     UPROPERTY()
     EIssueAttackOrdersStage Stage = EIssueAttackOrdersStage::CREATE_LEADER_ORDER;
+
+    /// @brief Waits on the `ORDER_VALIDATED` signal of each order being validated.
+    ///
+    /// While in a `VALIDATING_*` stage the task is parked and ticked when one of these is
+    /// signalled. Until the order system raises `ORDER_VALIDATED`, @ref UTaskWaitSubsystem also
+    /// wakes it every tick.
+    TArray<FTaskWaitHandle> PendingValidations;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -21,6 +21,7 @@
 #include "AI/MilVerseStateTreeTask.h"
 #include "Components/UnitControllerComponent.h"
 #include "Components/Units/UnitFormationComponent.h"
+#include "EntityAI/TaskWaitSubsystem.h"
 
 // Unreal Engine
 #include "CoreMinimal.h"
@@ -68,6 +69,13 @@ struct SIMULATIONBEHAVIORS_API FIssueDefendPositionOrdersTaskInstanceData
     UPROPERTY()
     EIssueDefendPositionOrdersStage Stage = EIssueDefendPositionOrdersStage::CREATE_ORDER;
 
+    /// @brief Waits on the `ORDER_VALIDATED` signal of each order being validated.
+    ///
+    /// While in a `VALIDATING_*` stage the task is parked and ticked when one of these is
+    /// signalled. Until the order system raises `ORDER_VALIDATED`, @ref UTaskWaitSubsystem also
+    /// wakes it every tick.
+    TArray<FTaskWaitHandle> PendingValidations;
+
     /// @brief Array or orders to be processed.
     UPROPERTY()
     TArray<TObjectPtr<UOrder>> Orders;
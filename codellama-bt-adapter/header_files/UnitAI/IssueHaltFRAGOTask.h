@@ -19,6 +19,7 @@
 // MilVerse
 #include "AI/MilVerseStateTreeTask.h"
 #include "Components/UnitControllerComponent.h"
+#include "UnitAI/UnitHaltSubsystem.h"
 
 // Unreal Engine
 #include "CoreMinimal.h"
@@ -54,6 +55,10 @@ struct SIMULATIONBEHAVIORS_API FIssueHaltFRAGOTaskInstanceData
 
 /// @brief Task for issuing Halt / Resume FRAGOs .
 ///
+/// The halt or resume is first broadcast through @ref UUnitHaltSubsystem so that all movement
+/// tasks of the unit and of every subunit below it react in the same frame; the FRAGO orders are
+/// issued afterwards as before.
+///
 /// This task uses the following ECS component(s). The task will fail if they are missing
 ///
 /// @ref FUnitControllerComponent
@@ -24,6 +24,7 @@
 #include "Components/Units/SegmentedRouteComponent.h"
 #include "Components/Units/UnitFormationComponent.h"
 #include "Routes/RoutePoint.h"
+#include "EntityAI/TaskWaitSubsystem.h"
 
 // Unreal Engine
 #include "CoreMinimal.h"
@@ -78,6 +79,13 @@ struct SIMULATIONBEHAVIORS_API FIssueMovementOrdersTaskInstanceData
     /// @brief The current stage of this task.
     UPROPERTY()
     EIssueMovementOrdersStage Stage = EIssueMovementOrdersStage::CREATE_LEADER_ORDER;
+
+    /// @brief Waits on the `ORDER_VALIDATED` signal of each order being validated.
+    ///
+    /// While in a `VALIDATING_*` stage the task is parked and ticked when one of these is
+    /// signalled. Until the order system raises `ORDER_VALIDATED`, @ref UTaskWaitSubsystem also
+    /// wakes it every tick.
+    TArray<FTaskWaitHandle> PendingValidations;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -55,6 +55,8 @@ struct FNotifyRouteCompletedTaskInstanceData
 ///
 /// When the leader completes their route, the unit the entity belongs to will notify the followers
 /// in the unit and its parent unit using the @ref LeaderCompletedRouteEvent state tree event.
+/// It also raises the unit's `ROUTE_COMPLETED` signal on @ref UTaskWaitSubsystem to wake tasks
+/// parked on the route, such as @ref FWaitForAllUnitOrderCompletionTask.
 ///
 /// @ingroup SimulationBehaviors-Module
 USTRUCT(meta = (MilVerseGenericLevel))
@@ -0,0 +1,39 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the ERelativeCombatPower enum.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "RelativeCombatPower.generated.h"
+
+/// @brief Specifies the possible relatives combat power between two forces.
+///
+/// @sa FUnitCombatPowerCondition
+/// @sa UUnitCombatPowerSubsystem
+///
+/// @ingroup SimulationBehaviors-Module
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ERelativeCombatPower : uint8
+{
+    Invalid    = 0 UMETA(Hidden),
+    Comparable = 1 << 0,
+    Superior   = 1 << 1,
+    Weaker     = 1 << 2,
+};
+
+ENUM_CLASS_FLAGS(ERelativeCombatPower);
@@ -26,7 +26,10 @@
 #include "CommonAI/CommonTypes.h"
 #include "Components/Engagement/CombatPowerComponent.h"
 #include "Components/UnitControllerComponent.h"
+#include "EntityAI/PlatformTypeWeapons.h"
+#include "EntityAI/PlatformWeaponCompatibilityMatrix.h"
 #include "SimTimer.h"
+#include "UnitAI/UnitEngagementEnvelope.h"
 
 #include "UnitCanEngageTargetCondition.generated.h"
 
@@ -42,10 +45,42 @@ struct FUnitCanEngageTargetConditionInstanceData
     /// @brief If set to true, Is the Enemy outside of our max engagement distance?
     UPROPERTY(EditAnywhere, Category = "Parameter")
     bool bInvert = false;
+
+    /// @brief If true, the target's platform type must also be engageable by the unit's weapons.
+    UPROPERTY(EditAnywhere, Category = "Parameter")
+    bool bCheckPlatformType = false;
+
+    /// @brief The different platform types and the weapons that can be fired at them.
+    UPROPERTY(EditAnywhere, Category = "Parameter", meta = (EditCondition = "bCheckPlatformType"))
+    TArray<FPlatformTypeWeapons> PlatformTypeWeapons;
+
+    /// @brief `PlatformTypeWeapons` compiled into a (platform type, weapon template) bit matrix
+    /// the first time the condition is tested.
+    FPlatformWeaponCompatibilityMatrix PlatformWeaponCompatibility;
+
+    /// @brief Platform types engageable by any member of the unit.
+    ///
+    /// Rebuilt from the members' weapon templates together with `EngagementEnvelope`, and also
+    /// when a member's templates change without its range changing, so the platform check is a
+    /// single bit test.
+    uint32 EngageablePlatformMask = 0;
+
+    /// @brief Members' weapon template indices `EngageablePlatformMask` was built from.
+    TArray<int32> MaskTemplateIndices;
+
+    /// @brief Union of the members' weapon ranges, used for the range test.
+    ///
+    /// Rebuilt only when a member moves more than `FUnitEngagementEnvelope::MoveTolerance`, a
+    /// member's range or loadout changes or the unit's membership changes (see
+    /// `RefreshEngagement`); otherwise the test is usually a single bin lookup.
+    FUnitEngagementEnvelope EngagementEnvelope;
 };
 
 /// @brief Can our unit engage the target?
 ///
+/// The target position is tested against the unit's engagement envelope rather than against each
+/// member's weapons and range.
+///
 /// @ingroup SimulationBehaviors-Module
 /// @ingroup UnitAI
 USTRUCT(meta = (MilVerseUnitLevel))
@@ -86,6 +121,37 @@ protected:
     virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
 
 private:
+    /// @brief Rebuilds the engagement envelope and the engageable platform mask if the unit's
+    /// membership, a member's range or loadout changed, or a member moved more than
+    /// `FUnitEngagementEnvelope::MoveTolerance`, since the last build.
+    ///
+    /// @param InstanceData
+    ///     The condition's instance data.
+    /// @param Positions
+    ///     Current ground plane position of each member.
+    /// @param Ranges
+    ///     Current maximum engagement distance of each member.
+    /// @param TemplateIndices
+    ///     Registry indices of the weapon templates carried by the members, member by member.
+    static void RefreshEngagement(FInstanceDataType& InstanceData,
+        TConstArrayView<FVector2D> Positions,
+        TConstArrayView<float> Ranges,
+        TConstArrayView<int32> TemplateIndices)
+    {
+        const TArray<int32>& BuiltIndices = InstanceData.MaskTemplateIndices;
+        const bool bLoadoutChanged = BuiltIndices.Num() != TemplateIndices.Num()
+            || FMemory::Memcmp(BuiltIndices.GetData(), TemplateIndices.GetData(),
+                   TemplateIndices.Num() * sizeof(int32)) != 0;
+        if (!bLoadoutChanged && !InstanceData.EngagementEnvelope.NeedsRebuild(Positions, Ranges))
+        {
+            return;
+        }
+        InstanceData.EngagementEnvelope.Build(Positions, Ranges);
+        InstanceData.MaskTemplateIndices = TArray<int32>(TemplateIndices);
+        InstanceData.EngageablePlatformMask =
+            InstanceData.PlatformWeaponCompatibility.GetEngageablePlatformMask(TemplateIndices);
+    }
+
     /// @brief Handle for the `FUnitControllerComponent` ECS component.
     TStateTreeExternalDataHandle<FUnitControllerComponent> UnitControllerHandle;
 };
\ No newline at end of file
@@ -23,26 +23,12 @@
 // MilVerse
 #include "AI/MilVerseStateTreeCondition.h"
 #include "CommonAI/CommonTypes.h"
-#include "Components/Engagement/CombatPowerComponent.h"
 #include "Components/UnitControllerComponent.h"
 #include "SimTimer.h"
+#include "UnitAI/RelativeCombatPower.h"
 
 #include "UnitCombatPowerCondition.generated.h"
 
-/// @brief Specifies the possible relatives combat power between two forces.
-///
-/// @ingroup SimulationBehaviors-Module
-UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
-enum class ERelativeCombatPower : uint8
-{
-    Invalid    = 0 UMETA(Hidden),
-    Comparable = 1 << 0,
-    Superior   = 1 << 1,
-    Weaker     = 1 << 2,
-};
-
-ENUM_CLASS_FLAGS(ERelativeCombatPower);
-
 /// @brief Instance data for `FUnitCombatPowerCondition`.
 ///
 /// @ingroup SimulationBehaviors-Module
@@ -58,6 +44,13 @@ struct FUnitCombatPowerConditionInstanceData
 /// Result of condition will depend on the EnemyCombatPowerIs setting. Also, if no enemy is detected
 /// this condition will always fail.
 ///
+/// Combat power is read from `UUnitCombatPowerSubsystem`, which keeps friendly and perceived enemy
+/// power of every unit up to date incrementally, subunits included; testing the condition does not
+/// sum anything.
+///
+/// This condition requires that the unit have the following components assigned:
+/// * `FUnitControllerComponent`
+///
 /// @ingroup SimulationBehaviors-Module
 USTRUCT()
 struct FUnitCombatPowerCondition : public FMilVerseStateTreeCondition
@@ -107,6 +100,6 @@ protected:
     int32 EnemyCombatPowerIs = 0;
 
 private:
-    /// @brief Handle for the `FCombatPowerComponent` ECS component.
-    TStateTreeExternalDataHandle<FCombatPowerComponent> UnitCombatPowerHandle;
+    /// @brief Handle for the `FUnitControllerComponent` ECS component, which identifies the unit.
+    TStateTreeExternalDataHandle<FUnitControllerComponent> UnitControllerHandle;
 };
\ No newline at end of file
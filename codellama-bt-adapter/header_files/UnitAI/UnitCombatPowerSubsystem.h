@@ -0,0 +1,123 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UUnitCombatPowerSubsystem class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "UnitAI/CombatPowerHierarchy.h"
+#include "UnitAI/RelativeCombatPower.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UnitCombatPowerSubsystem.generated.h"
+
+/// @brief Combat power engine: friendly and perceived enemy combat power of every unit.
+///
+/// Owns the scene's `FCombatPowerHierarchy` and feeds it from simulation changes instead of
+/// recomputing combat power when a condition is tested:
+/// * members are removed when `UnitMemberDestroyedEvent` is raised,
+/// * member power is updated when `FCombatPowerComponent` changes (damage, resupply),
+/// * contacts are added, updated and removed as the unit's sensing changes.
+///
+/// `FUnitCombatPowerCondition` reads the totals of its unit, subunits included, so a company or
+/// battalion level tree gets its roll-up at the same cost as a platoon.
+///
+/// @sa FUnitCombatPowerCondition
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup UnitAI
+UCLASS()
+class SIMULATIONBEHAVIORS_API UUnitCombatPowerSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Returns the aggregates. Updates go through the subsystem's handlers.
+    const FCombatPowerHierarchy& GetHierarchy() const
+    {
+        return Hierarchy;
+    }
+
+    /// @brief Adds a unit. Parents must be added before their subunits.
+    void AddUnit(const FGuid& UnitId, const FGuid& ParentUnitId)
+    {
+        Hierarchy.AddUnit(UnitId, ParentUnitId);
+    }
+
+    /// @brief Called when a member's `FCombatPowerComponent` changes.
+    void OnMemberCombatPowerChanged(const FGuid& UnitId, const FGuid& MemberId, const float Power)
+    {
+        Hierarchy.SetMemberPower(UnitId, MemberId, Power);
+    }
+
+    /// @brief Called when `UnitMemberDestroyedEvent` is raised for a member.
+    void OnMemberDestroyed(const FGuid& MemberId)
+    {
+        Hierarchy.RemoveMember(MemberId);
+    }
+
+    /// @brief Called when a unit senses a contact or the contact's perceived power changes.
+    void OnContactSensed(const FGuid& UnitId, const FGuid& ContactId, const float Power)
+    {
+        Hierarchy.SetContactPower(UnitId, ContactId, Power);
+    }
+
+    /// @brief Called when a unit loses a contact.
+    void OnContactLost(const FGuid& UnitId, const FGuid& ContactId)
+    {
+        Hierarchy.RemoveContact(UnitId, ContactId);
+    }
+
+    /// @brief Called when a contact is destroyed.
+    void OnContactDestroyed(const FGuid& ContactId)
+    {
+        Hierarchy.RemoveContactEverywhere(ContactId);
+    }
+
+    /// @brief Returns the enemy's combat power relative to a unit's, subunits included.
+    ///
+    /// The enemy is `Superior` when its total is greater than the unit's, `Weaker` when it is
+    /// smaller and `Comparable` only when both totals are equal.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @returns
+    ///     `ERelativeCombatPower::Invalid` if the unit and its subunits perceive no contact.
+    ERelativeCombatPower GetRelativeCombatPower(const FGuid& UnitId) const
+    {
+        if (Hierarchy.GetNumContacts(UnitId) == 0)
+        {
+            return ERelativeCombatPower::Invalid;
+        }
+        const float Friendly = Hierarchy.GetFriendlyPower(UnitId);
+        const float Enemy = Hierarchy.GetEnemyPower(UnitId);
+        if (Enemy > Friendly)
+        {
+            return ERelativeCombatPower::Superior;
+        }
+        if (Enemy < Friendly)
+        {
+            return ERelativeCombatPower::Weaker;
+        }
+        return ERelativeCombatPower::Comparable;
+    }
+
+private:
+    /// @brief The scene's combat power aggregates.
+    FCombatPowerHierarchy Hierarchy;
+};
@@ -23,6 +23,7 @@
 #include "CommonAI/CommonTypes.h"
 #include "Components/UnitControllerComponent.h"
 #include "Components/UnitControllerSensedEntitiesComponent.h"
+#include "EntityAI/ThreatTrackSubsystem.h"
 #include "Events/SensedEntityUpdateEvent.h"
 
 #include "UnitEnemySituationEvaluator.generated.h"
@@ -56,7 +57,10 @@ struct FUnitEnemySituationEvaluatorInstanceData
 /// @brief Aggregates all of the units sensed entities and is able to make decisions based on
 /// sensing.
 ///
-///
+/// The unit's sensed entities are the union of its members' sensing, so most of their threat
+/// tracks were already fused from the same samples by the members' `FEnemySituationEvaluator`;
+/// those are read from `UThreatTrackSubsystem` instead of being derived again. Threat priority is
+/// scored by the unit itself from those tracks.
 ///
 /// @ingroup SimulationBehaviors-Module
 /// @ingroup EntityAI
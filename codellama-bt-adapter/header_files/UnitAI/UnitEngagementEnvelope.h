@@ -0,0 +1,264 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the FUnitEngagementEnvelope.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// Unreal Engine
+#include "CoreMinimal.h"
+
+/// @brief Polar range profile of the area a unit can engage.
+///
+/// The envelope is the union of its members' weapon range discs in the ground plane, described
+/// around the members' centroid by `NumBins` angular bins. Each bin stores two radii:
+/// * inner: every point of the bin closer than this is inside some member's range.
+/// * outer: no point of the bin farther than this is inside any member's range.
+///
+/// Both bounds are exact rather than sampled, so `Contains` answers most queries with one bin
+/// lookup and only checks each member for points in the band between the two radii. Bins are
+/// laid out on the "diamond angle" (a monotonic, division-only stand-in for `atan2`) so no
+/// trigonometry is needed per query.
+///
+/// The envelope only needs rebuilding when a member moves more than `MoveTolerance` from where
+/// it was at the last build or when any member's range changes (loadout or ammunition). The
+/// inner and outer bounds are computed with ranges shrunk and grown by the tolerance so they stay
+/// valid in between; the per-member fallback is given the members' current positions, so it is
+/// exact regardless of how far they moved since the build.
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup UnitAI
+struct FUnitEngagementEnvelope
+{
+    /// @brief Number of angular bins.
+    static constexpr int32 NumBins = 64;
+
+    /// @brief Distance a member may move before the envelope must be rebuilt (Unreal units, cm).
+    float MoveTolerance = 5000.f;
+
+    /// @brief Rebuilds the envelope.
+    ///
+    /// @param Positions
+    ///     Ground plane position of each member.
+    /// @param Ranges
+    ///     Maximum engagement distance of each member. Members with no range are skipped.
+    void Build(TConstArrayView<FVector2D> Positions, TConstArrayView<float> Ranges)
+    {
+        MemberPositions = TArray<FVector2D>(Positions);
+        MemberRanges = TArray<float>(Ranges);
+        Center = FVector2D::ZeroVector;
+        for (const FVector2D& Position : Positions)
+        {
+            Center += Position;
+        }
+        Center /= FMath::Max(Positions.Num(), 1);
+
+        float Inner[NumBins] = {};
+        float Outer[NumBins] = {};
+
+        for (int32 Member = 0; Member < Positions.Num(); ++Member)
+        {
+            if (Ranges[Member] <= 0.f)
+            {
+                continue;
+            }
+            const float OuterRange = Ranges[Member] + MoveTolerance;
+            const float InnerRange = Ranges[Member] - MoveTolerance;
+            const FVector2D Offset = Positions[Member] - Center;
+            const float OffsetSize = Offset.Size();
+            const float Reach = OffsetSize + OuterRange;
+
+            // Outer: the disc lies within +/- asin(Range / OffsetSize) of its direction.
+            int32 FirstBin = 0;
+            int32 LastBin = NumBins - 1;
+            if (OffsetSize > OuterRange)
+            {
+                const float Direction = FMath::Atan2(Offset.Y, Offset.X);
+                const float HalfWidth = FMath::Asin(OuterRange / OffsetSize);
+                const float First = DiamondAngle(
+                    FVector2D(FMath::Cos(Direction - HalfWidth), FMath::Sin(Direction - HalfWidth)));
+                float Last = DiamondAngle(
+                    FVector2D(FMath::Cos(Direction + HalfWidth), FMath::Sin(Direction + HalfWidth)));
+                Last = Last < First ? Last + 4.f : Last;
+                FirstBin = FMath::FloorToInt(First * BinsPerUnit);
+                LastBin = FMath::FloorToInt(Last * BinsPerUnit);
+            }
+            for (int32 Bin = FirstBin; Bin <= LastBin; ++Bin)
+            {
+                float& BinOuter = Outer[Bin % NumBins];
+                BinOuter = FMath::Max(BinOuter, Reach);
+            }
+
+            // Inner: only discs containing the centre cover a whole ray segment from it. The
+            // distance to the disc boundary grows with Offset|Dir, so its minimum over a bin is
+            // reached where Offset|Dir is smallest.
+            if (OffsetSize < InnerRange)
+            {
+                const float RangeSqMinusOffsetSq = InnerRange * InnerRange - OffsetSize * OffsetSize;
+                for (int32 Bin = 0; Bin < NumBins; ++Bin)
+                {
+                    const float MinProjection = MinProjectionOverBin(Offset, OffsetSize, Bin);
+                    const float Distance = MinProjection
+                        + FMath::Sqrt(RangeSqMinusOffsetSq + MinProjection * MinProjection);
+                    Inner[Bin] = FMath::Max(Inner[Bin], Distance);
+                }
+            }
+        }
+
+        for (int32 Bin = 0; Bin < NumBins; ++Bin)
+        {
+            InnerSq[Bin] = Inner[Bin] * Inner[Bin];
+            OuterSq[Bin] = Outer[Bin] * Outer[Bin];
+        }
+    }
+
+    /// @brief Returns `true` if the membership or any member's range changed, or any member moved
+    /// more than `MoveTolerance`, since the last build.
+    ///
+    /// @param Positions
+    ///     Current ground plane position of each member.
+    /// @param Ranges
+    ///     Current maximum engagement distance of each member.
+    bool NeedsRebuild(TConstArrayView<FVector2D> Positions, TConstArrayView<float> Ranges) const
+    {
+        if (Positions.Num() != MemberPositions.Num() || Ranges.Num() != MemberRanges.Num())
+        {
+            return true;
+        }
+        for (int32 Member = 0; Member < Ranges.Num(); ++Member)
+        {
+            if (Ranges[Member] != MemberRanges[Member])
+            {
+                return true;
+            }
+        }
+        const float ToleranceSq = MoveTolerance * MoveTolerance;
+        for (int32 Member = 0; Member < Positions.Num(); ++Member)
+        {
+            if (FVector2D::DistSquared(Positions[Member], MemberPositions[Member]) > ToleranceSq)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Returns `true` if the point is within range of at least one member.
+    ///
+    /// @param Point
+    ///     Ground plane position to test.
+    /// @param Positions
+    ///     Current ground plane position of each member, in build order. Only read for points
+    ///     between the inner and outer radii. Call `NeedsRebuild` first so the members match.
+    bool Contains(const FVector2D& Point, TConstArrayView<FVector2D> Positions) const
+    {
+        const FVector2D Offset = Point - Center;
+        const float DistanceSq = Offset.SizeSquared();
+        const int32 Bin = FMath::Min(FMath::FloorToInt(DiamondAngle(Offset) * BinsPerUnit), NumBins - 1);
+
+        if (DistanceSq <= InnerSq[Bin])
+        {
+            return true;
+        }
+        if (DistanceSq > OuterSq[Bin])
+        {
+            return false;
+        }
+        return ContainsExact(Point, Positions);
+    }
+
+    /// @brief Checks every member's range from its current position. Used for points between the
+    /// inner and outer radii.
+    bool ContainsExact(const FVector2D& Point, TConstArrayView<FVector2D> Positions) const
+    {
+        check(Positions.Num() == MemberRanges.Num());
+        for (int32 Member = 0; Member < Positions.Num(); ++Member)
+        {
+            const float Range = MemberRanges[Member];
+            if (Range > 0.f && FVector2D::DistSquared(Point, Positions[Member]) <= Range * Range)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    /// @brief Number of bins per unit of diamond angle.
+    static constexpr float BinsPerUnit = NumBins / 4.f;
+
+    /// @brief Maps a direction to [0, 4), monotonically in its angle, without trigonometry.
+    static float DiamondAngle(const FVector2D& Direction)
+    {
+        const float X = Direction.X;
+        const float Y = Direction.Y;
+        if (X == 0.f && Y == 0.f)
+        {
+            return 0.f;
+        }
+        if (Y >= 0.f)
+        {
+            return X >= 0.f ? Y / (X + Y) : 1.f - X / (Y - X);
+        }
+        return X < 0.f ? 2.f - Y / (-X - Y) : 3.f + X / (X - Y);
+    }
+
+    /// @brief Returns the unit direction at a diamond angle.
+    static FVector2D DiamondDirection(const float Angle)
+    {
+        const int32 Quadrant = FMath::FloorToInt(Angle) & 3;
+        const float Fraction = Angle - FMath::FloorToFloat(Angle);
+        FVector2D Direction;
+        switch (Quadrant)
+        {
+            case 0: Direction = FVector2D(1.f - Fraction, Fraction); break;
+            case 1: Direction = FVector2D(-Fraction, 1.f - Fraction); break;
+            case 2: Direction = FVector2D(Fraction - 1.f, -Fraction); break;
+            default: Direction = FVector2D(Fraction, Fraction - 1.f); break;
+        }
+        return Direction / Direction.Size();
+    }
+
+    /// @brief Smallest value of Offset|Dir over the directions of a bin.
+    static float MinProjectionOverBin(const FVector2D& Offset, const float OffsetSize, const int32 Bin)
+    {
+        const float Start = Bin / BinsPerUnit;
+        const float End = (Bin + 1) / BinsPerUnit;
+        float MinProjection = FMath::Min(Offset | DiamondDirection(Start), Offset | DiamondDirection(End));
+
+        // The projection is -OffsetSize when the bin contains the direction opposite the offset.
+        const float Opposite = DiamondAngle(-Offset);
+        if (Opposite >= Start && Opposite <= End)
+        {
+            MinProjection = -OffsetSize;
+        }
+        return MinProjection;
+    }
+
+    /// @brief Member positions at the last build.
+    TArray<FVector2D> MemberPositions;
+
+    /// @brief Member ranges at the last build, compared by `NeedsRebuild`.
+    TArray<float> MemberRanges;
+
+    /// @brief Centroid of the members at the last build.
+    FVector2D Center = FVector2D::ZeroVector;
+
+    /// @brief Squared guaranteed-covered radius of each bin.
+    float InnerSq[NumBins] = {};
+
+    /// @brief Squared maximum reachable radius of each bin.
+    float OuterSq[NumBins] = {};
+};
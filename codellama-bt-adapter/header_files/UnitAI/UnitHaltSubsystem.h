@@ -0,0 +1,169 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the UUnitHaltSubsystem class.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// MilVerse
+#include "UnitAI/UnitHierarchy.h"
+
+// Unreal Engine
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UnitHaltSubsystem.generated.h"
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Latency between a halt broadcast and its members reaching zero velocity.
+///
+/// @ingroup SimulationBehaviors-Module
+USTRUCT()
+struct SIMULATIONBEHAVIORS_API FHaltLatencyStats
+{
+    GENERATED_BODY()
+
+    /// @brief Number of members that reported reaching zero velocity after a halt.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    int32 NumSamples = 0;
+
+    /// @brief Sum of all halt latencies, in seconds.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    double TotalLatencySeconds = 0.0;
+
+    /// @brief Largest halt latency observed, in seconds.
+    UPROPERTY(VisibleAnywhere, Category = Output)
+    double MaxLatencySeconds = 0.0;
+
+    /// @brief Returns the mean halt latency in seconds, or 0 if there are no samples.
+    double GetMeanLatencySeconds() const
+    {
+        return NumSamples > 0 ? TotalLatencySeconds / NumSamples : 0.0;
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Unit-wide halt fast path for movement tasks.
+///
+/// @ref FIssueHaltFRAGOTask broadcasts the halt here before issuing the FRAGO orders. The halt is
+/// stored as one bit per unit, which @ref FMoveTask and @ref FFollowLeaderTask test at the start
+/// of their tick, so every mover of the unit stops in the same frame instead of waiting for the
+/// orders to propagate one echelon per tick. The per-task `bIsHalted` flags still apply for
+/// halts issued through orders.
+///
+/// A halt applies to the whole subtree of the unit: `IsHalted` walks up from a member's own unit
+/// through its ancestors in the subsystem's `FUnitHierarchy` (registered with `AddUnit`), so a company-level halt stops the
+/// members of every platoon and squad below it in the same frame. The walk is bounded by the
+/// echelon depth, typically 3-5 units.
+///
+/// Each halt is stamped with the simulation time it was broadcast. Movement tasks report when
+/// their entity reaches zero velocity, and the difference is accumulated in `FHaltLatencyStats`.
+///
+/// @ingroup SimulationBehaviors-Module
+UCLASS()
+class SIMULATIONBEHAVIORS_API UUnitHaltSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /// @brief Adds a unit so that halts of its parent reach the unit's members. Parents must be
+    /// added before their subunits.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit controller.
+    /// @param ParentUnitId
+    ///     Global id of the parent unit controller, or an invalid id for a top-level unit.
+    void AddUnit(const FGuid& UnitId, const FGuid& ParentUnitId)
+    {
+        FindOrAddUnit(UnitId, ParentUnitId);
+    }
+
+    /// @brief Halts or resumes every movement task of a unit and of all units below it.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit controller.
+    /// @param bHalt
+    ///     `true` to halt the unit, `false` to resume it.
+    /// @param SimTimeSeconds
+    ///     Simulation time of the halt command, used as the start of the latency measurement.
+    void BroadcastHalt(const FGuid& UnitId, const bool bHalt, const double SimTimeSeconds);
+
+    /// @brief Returns `true` if the unit or any of its ancestor units is halted.
+    bool IsHalted(const FGuid& UnitId) const
+    {
+        const int32 Index = Hierarchy.Find(UnitId);
+        return Index != INDEX_NONE && FindHaltingUnit(Index) != INDEX_NONE;
+    }
+
+    /// @brief Returns the serial of the most recent halt applying to the unit (its own or an
+    /// ancestor's), or 0 if it is not halted.
+    ///
+    /// Tasks compare it with the serial they last reported to record one latency sample per halt.
+    uint32 GetHaltSerial(const FGuid& UnitId) const;
+
+    /// @brief Records that a member of a halted unit reached zero velocity.
+    ///
+    /// The latency is measured from the broadcast of the halting unit, which may be an ancestor.
+    ///
+    /// @param UnitId
+    ///     Global id of the member's unit controller.
+    /// @param SimTimeSeconds
+    ///     Simulation time at which the member was observed stopped.
+    void ReportStopped(const FGuid& UnitId, const double SimTimeSeconds);
+
+    /// @brief Returns the halt latency statistics gathered so far.
+    const FHaltLatencyStats& GetLatencyStats() const
+    {
+        return LatencyStats;
+    }
+
+    /// @brief Clears the halt latency statistics.
+    void ResetLatencyStats();
+
+private:
+    /// @brief Returns the index of a unit in `Hierarchy`, adding it and its halt state if it is
+    /// not registered yet.
+    int32 FindOrAddUnit(const FGuid& UnitId, const FGuid& ParentUnitId = FGuid());
+
+    /// @brief Returns the index of the nearest halted unit among `Index` and its ancestors, or
+    /// `INDEX_NONE` if none is halted.
+    int32 FindHaltingUnit(int32 Index) const
+    {
+        for (; Index != INDEX_NONE; Index = Hierarchy.GetParent(Index))
+        {
+            if (HaltedUnits[Index])
+            {
+                return Index;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    /// @brief Units of the scene; its unit indices index the arrays below.
+    FUnitHierarchy Hierarchy;
+
+    /// @brief Halted bit of each unit.
+    TBitArray<> HaltedUnits;
+
+    /// @brief Simulation time of each unit's most recent halt, in seconds.
+    TArray<double> HaltTimes;
+
+    /// @brief Serial of each unit's most recent halt.
+    TArray<uint32> HaltSerials;
+
+    /// @brief Latency of halt commands to zero velocity.
+    FHaltLatencyStats LatencyStats;
+};
@@ -0,0 +1,119 @@
+//--|====================================================================|--
+//--| CLASSIFICATION: UNCLASSIFIED
+//--|====================================================================|--
+//--| This program is the sole property of the Lockheed Martin Corporation
+//--| and contains proprietary and confidential information. Use or
+//--| disclosure of this program is subject to the terms and conditions of
+//--| a license agreement with the Lockheed Martin Corporation. Unauthorized
+//--| use or distribution will be subject to action as prescribed by the
+//--| license agreement.
+//--|
+//--| Copyright 2024 by Lockheed Martin Corporation
+//--|====================================================================|--
+//--|
+//--| Description:
+//--| Defines the FUnitHierarchy unit index and parent/child structure.
+//--|
+//--|====================================================================|--
+#pragma once
+
+// Unreal Engine
+#include "CoreMinimal.h"
+
+/// @brief Dense indices and parent/child links of the units of a scene.
+///
+/// Aggregates maintained per unit and rolled up the echelons (combat power, readiness) keep
+/// their per-unit values in arrays indexed by the unit index assigned here, and walk
+/// `ForEachAncestor` to apply a change to a unit and every unit above it. Indices are assigned
+/// in registration order and never reused.
+///
+/// @sa FCombatPowerHierarchy
+/// @sa UCombatReadinessSubsystem
+/// @sa UUnitHaltSubsystem
+///
+/// @ingroup SimulationBehaviors-Module
+/// @ingroup UnitAI
+class FUnitHierarchy
+{
+public:
+    /// @brief Adds a unit. Parents must be added before their subunits.
+    ///
+    /// @param UnitId
+    ///     Global id of the unit.
+    /// @param ParentUnitId
+    ///     Global id of the parent unit, or an invalid id for a top level unit.
+    /// @param bOutAdded
+    ///     Assigned `true` if the unit was new, `false` if it was already added.
+    /// @returns
+    ///     The index of the unit.
+    int32 AddUnit(const FGuid& UnitId, const FGuid& ParentUnitId, bool& bOutAdded)
+    {
+        if (const int32* Existing = UnitIndices.Find(UnitId))
+        {
+            bOutAdded = false;
+            return *Existing;
+        }
+        const int32 Index = UnitIds.Add(UnitId);
+        const int32* ParentIndex = UnitIndices.Find(ParentUnitId);
+        ParentIndices.Add(ParentIndex ? *ParentIndex : INDEX_NONE);
+        Children.AddDefaulted();
+        if (ParentIndex)
+        {
+            Children[*ParentIndex].Add(Index);
+        }
+        UnitIndices.Add(UnitId, Index);
+        bOutAdded = true;
+        return Index;
+    }
+
+    /// @brief Returns the index of a unit, or `INDEX_NONE` if it was not added.
+    int32 Find(const FGuid& UnitId) const
+    {
+        const int32* Index = UnitIndices.Find(UnitId);
+        return Index ? *Index : INDEX_NONE;
+    }
+
+    /// @brief Returns the number of units.
+    int32 Num() const
+    {
+        return UnitIds.Num();
+    }
+
+    /// @brief Returns the global id of the unit at an index.
+    const FGuid& GetUnitId(const int32 Index) const
+    {
+        return UnitIds[Index];
+    }
+
+    /// @brief Returns the index of the parent of the unit at an index, or `INDEX_NONE`.
+    int32 GetParent(const int32 Index) const
+    {
+        return ParentIndices[Index];
+    }
+
+    /// @brief Returns the indices of the direct subunits of the unit at an index.
+    TConstArrayView<int32> GetChildren(const int32 Index) const
+    {
+        return Children[Index];
+    }
+
+    /// @brief Calls a function with the index of a unit and then of each of its ancestors, up to
+    /// the top level unit.
+    template <typename FunctorType>
+    void ForEachAncestor(const int32 Index, FunctorType&& Visit) const
+    {
+        for (int32 Current = Index; Current != INDEX_NONE; Current = ParentIndices[Current])
+        {
+            Visit(Current);
+        }
+    }
+
+private:
+    /// @brief Per-unit data, indexed by unit index.
+    TArray<FGuid> UnitIds;
+    TArray<int32> ParentIndices;
+    TArray<TArray<int32>> Children;
+
+    /// @brief Index of each unit.
+    TMap<FGuid, int32> UnitIndices;
+};
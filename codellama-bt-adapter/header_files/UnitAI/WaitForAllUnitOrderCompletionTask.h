@@ -21,6 +21,7 @@
 #include "AI/MilVerseStateTreeTask.h"
 #include "Components/UnitControllerComponent.h"
 #include "Components/Units/SegmentedRouteComponent.h"
+#include "EntityAI/TaskWaitSubsystem.h"
 
 // Unreal Engine
 #include "CoreMinimal.h"
@@ -41,10 +42,18 @@ struct FWaitForAllUnitOrderCompletionTaskInstanceData
     /// @brief Right Unit Route Is Complete.
     UPROPERTY()
     bool bRightRouteComplete = false;
+
+    /// @brief Wait on the left unit's route completion.
+    FTaskWaitHandle LeftRouteWait;
+
+    /// @brief Wait on the right unit's route completion.
+    FTaskWaitHandle RightRouteWait;
 };
 
 /// @brief WaitForAllUnitOrderCompletionTask
 ///
+/// Parks on the `ROUTE_COMPLETED` signal of each subunit with @ref UTaskWaitSubsystem instead of
+/// polling the routes every tick. The task is only ticked when one of them is signalled.
 ///
 /// @ingroup SimulationBehaviors-Module
 USTRUCT(meta = (MilVerseUnitLevel))
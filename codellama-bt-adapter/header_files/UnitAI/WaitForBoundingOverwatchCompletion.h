@@ -21,6 +21,7 @@
 #include "AI/MilVerseStateTreeTask.h"
 #include "Components/UnitControllerComponent.h"
 #include "OrderSubsystem.h"
+#include "EntityAI/TaskWaitSubsystem.h"
 
 // Unreal Engine
 #include "CoreMinimal.h"
@@ -49,10 +50,16 @@ struct FWaitForBoundingOverwatchCompletionInstanceData
     /// @brief Active order guid
     UPROPERTY()
     FGuid OrderGuid;
+
+    /// @brief Wait on the `ORDER_COMPLETED` signal of `OrderGuid`.
+    FTaskWaitHandle OrderWait;
 };
 
 /// @brief Wait For Bounding Overwatch Order Completion Task
 ///
+/// Parks on the active order's completion with @ref UTaskWaitSubsystem. `CheckForCompletion` is
+/// run once after parking, then whenever the task is woken: when the order is signalled, and every
+/// tick until the order system raises `ORDER_COMPLETED`.
 ///
 /// @ingroup SimulationBehaviors-Module
 USTRUCT(meta = (MilVerseUnitLevel))
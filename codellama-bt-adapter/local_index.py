@@ -0,0 +1,460 @@
+# local_index.py
+"""
+Local, memory-mapped vector index used in place of the Pinecone service.
+
+The index is an IVF-flat index over unit-normalized embeddings (cosine similarity):
+vectors are clustered with k-means and stored contiguously per cluster, and a query only
+scans the nprobe clusters whose centroids are closest to it. Below FLAT_SCAN_THRESHOLD
+vectors a single cluster is used, i.e. every query is an exact flat scan: at that size
+scanning everything is faster than probing clusters and loses no recall. Above it, save()
+picks the smallest nprobe reaching TARGET_RECALL on a sample of the stored vectors.
+
+An index path is a symbolic link to the current version directory, <path>.v<n>. save()
+writes a new version and repoints the link with an atomic rename, so a reader finds
+either the old or the new index, never none. Files of a version directory:
+
+    vectors.npy     float32 (N, dim), ordered by cluster, memory-mapped at query time
+    centroids.npy   float32 (nlist, dim)
+    offsets.npy     int64 (nlist + 1), start of each cluster in vectors.npy
+    records.jsonl   id and metadata of each vector, in the order of vectors.npy
+    settings.json   default nprobe
+
+LocalVectorIndex.query has the signature and result shape of the Pinecone index.query used
+by retrieve_context.py.
+
+Usage:
+    python3 local_index.py benchmark indexes/pdf-rag-index [--top-k 5]
+    python3 local_index.py benchmark --synthetic 20000
+"""
+import argparse
+import glob
+import json
+import logging
+import os
+import shutil
+import statistics
+import time
+
+import numpy as np
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+INDEX_ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "indexes")
+
+# Indexes with fewer vectors are stored as one cluster and scanned exhaustively
+FLAT_SCAN_THRESHOLD = 20000
+
+# Recall@k against brute force that the nprobe chosen by save() must reach
+TARGET_RECALL = 0.95
+
+class QueryMatch:
+    """A single query match: id, cosine similarity score and metadata."""
+
+    def __init__(self, id, score, metadata=None):
+        self.id = id
+        self.score = score
+        if metadata is not None:
+            self.metadata = metadata
+
+class QueryResult:
+    """Matches of a query, best first."""
+
+    def __init__(self, matches):
+        self.matches = matches
+
+def local_index_path(index_name):
+    """Returns the directory of a local index, LOCAL_INDEX_ROOT/<index_name> or indexes/<index_name>."""
+    return os.path.join(os.getenv('LOCAL_INDEX_ROOT', INDEX_ROOT), index_name)
+
+def normalize(vectors):
+    """Scales vectors to unit length so that dot products are cosine similarities."""
+    vectors = np.asarray(vectors, dtype=np.float32)
+    norms = np.linalg.norm(vectors, axis=-1, keepdims=True)
+    return vectors / np.maximum(norms, 1e-12)
+
+def exact_top_k(scores, top_k):
+    """Returns the positions of the top_k scores, best first."""
+    count = min(top_k, len(scores))
+    best = np.argpartition(-scores, count - 1)[:count]
+    return best[np.argsort(-scores[best])]
+
+def kmeans(vectors, nlist, iterations=20, seed=0):
+    """
+    Spherical k-means.
+
+    Args:
+        vectors (np.ndarray): Unit vectors (N, dim)
+        nlist (int): Number of clusters
+        iterations (int): Lloyd iterations
+        seed (int): Seed of the initial centroid sample
+
+    Returns:
+        tuple: (centroids (nlist, dim), cluster of each vector (N,))
+    """
+    rng = np.random.default_rng(seed)
+    centroids = vectors[rng.choice(len(vectors), nlist, replace=False)].copy()
+    for _ in range(iterations):
+        assignments = np.argmax(vectors @ centroids.T, axis=1)
+        for cluster in range(nlist):
+            members = vectors[assignments == cluster]
+            if len(members):
+                centroids[cluster] = members.sum(axis=0)
+            else:
+                # Reseed empty clusters with a random vector
+                centroids[cluster] = vectors[rng.integers(len(vectors))]
+        centroids = normalize(centroids)
+    return centroids, np.argmax(vectors @ centroids.T, axis=1)
+
+class LocalVectorIndex:
+    """
+    IVF-flat index stored in a directory.
+
+    Upserts and deletes are staged in memory and written by save(), which rebuilds the clusters.
+
+    Args:
+        path (str): Index path, a link to the current version directory
+        nprobe (int): Clusters scanned per query, or None for the one chosen by save()
+    """
+
+    def __init__(self, path, nprobe=None):
+        self.path = path
+        self.nprobe = nprobe
+        self.pending = {}
+        self.deleted = set()
+        self.load()
+
+    def load(self, attempts=3):
+        """Memory-maps the index files, if the index was saved before."""
+        self.vectors = None
+        self.centroids = None
+        self.offsets = None
+        self.records = []
+        self.default_nprobe = None
+        for attempt in range(attempts):
+            # Every file is read from the same version, even if save() repoints the link meanwhile
+            version = os.path.realpath(self.path)
+            self.version = version
+            if not os.path.exists(os.path.join(version, "records.jsonl")):
+                return
+            try:
+                self.vectors = np.load(os.path.join(version, "vectors.npy"), mmap_mode='r')
+                self.centroids = np.load(os.path.join(version, "centroids.npy"))
+                self.offsets = np.load(os.path.join(version, "offsets.npy"))
+                with open(os.path.join(version, "records.jsonl"), 'r', encoding='utf-8') as f:
+                    self.records = [json.loads(line) for line in f]
+                settings_path = os.path.join(version, "settings.json")
+                if os.path.exists(settings_path):
+                    with open(settings_path, 'r', encoding='utf-8') as f:
+                        self.default_nprobe = json.load(f).get("nprobe")
+                return
+            except FileNotFoundError:
+                # The version was replaced and removed while reading it
+                if attempt == attempts - 1:
+                    raise
+
+    def reload_if_replaced(self):
+        """
+        Reloads the index if save() (e.g. of a re-ingest in another process) repointed the link
+        to a new version since it was loaded.
+
+        Returns:
+            bool: True if the index was reloaded
+        """
+        if os.path.realpath(self.path) == self.version:
+            return False
+        self.load()
+        return True
+
+    def __len__(self):
+        return len(self.records)
+
+    def upsert(self, vectors):
+        """
+        Stages vectors, replacing any vector with the same id.
+
+        Args:
+            vectors (list): (id, values, metadata) tuples, as for a Pinecone index
+        """
+        for vector_id, values, metadata in vectors:
+            self.pending[str(vector_id)] = (values, metadata)
+            self.deleted.discard(str(vector_id))
+
+    def delete(self, ids):
+        """
+        Stages the removal of vectors, as for a Pinecone index.
+
+        Args:
+            ids (list): Ids of the vectors to remove
+        """
+        for vector_id in ids:
+            self.pending.pop(str(vector_id), None)
+            self.deleted.add(str(vector_id))
+
+    def ids(self):
+        """Returns the ids of the saved vectors."""
+        return {record["id"] for record in self.records}
+
+    def save(self, nlist=None):
+        """
+        Merges the staged vectors and deletes into the index and writes it.
+
+        Args:
+            nlist (int): Number of clusters, or None for 1 below FLAT_SCAN_THRESHOLD vectors
+                and about 4 * sqrt(N) above
+        """
+        if not self.pending and not self.deleted & self.ids():
+            self.deleted = set()
+            return
+
+        ids = []
+        vectors = []
+        metadata = []
+        for position, record in enumerate(self.records):
+            if record["id"] not in self.pending and record["id"] not in self.deleted:
+                ids.append(record["id"])
+                vectors.append(np.asarray(self.vectors[position]))
+                metadata.append(record.get("metadata"))
+        for vector_id, (values, vector_metadata) in self.pending.items():
+            ids.append(vector_id)
+            vectors.append(np.asarray(values, dtype=np.float32))
+            metadata.append(vector_metadata)
+
+        if not ids:
+            # Everything was deleted
+            self.vectors = None
+            if os.path.islink(self.path):
+                os.unlink(self.path)
+            else:
+                shutil.rmtree(self.path, ignore_errors=True)
+            self.remove_versions()
+            self.pending = {}
+            self.deleted = set()
+            self.load()
+            logger.info(f"Removed every vector from {self.path}")
+            return
+
+        vectors = normalize(np.stack(vectors))
+        if nlist is None and len(vectors) < FLAT_SCAN_THRESHOLD:
+            nlist = 1
+        nlist = nlist or max(1, min(len(vectors), int(4 * np.sqrt(len(vectors)))))
+        if nlist == 1:
+            centroids = normalize(vectors.sum(axis=0, keepdims=True))
+            assignments = np.zeros(len(vectors), dtype=np.int64)
+        else:
+            centroids, assignments = kmeans(vectors, nlist)
+        order = np.argsort(assignments, kind="stable")
+        offsets = np.concatenate([[0], np.cumsum(np.bincount(assignments, minlength=nlist))]).astype(np.int64)
+        vectors = vectors[order]
+        nprobe = choose_nprobe(vectors, centroids, offsets)
+
+        # Write a new version next to the current one
+        parent = os.path.dirname(os.path.abspath(self.path))
+        os.makedirs(parent, exist_ok=True)
+        version = f"{os.path.abspath(self.path)}.v{time.time_ns()}"
+        os.makedirs(version)
+        np.save(os.path.join(version, "vectors.npy"), vectors)
+        np.save(os.path.join(version, "centroids.npy"), centroids)
+        np.save(os.path.join(version, "offsets.npy"), offsets)
+        with open(os.path.join(version, "records.jsonl"), 'w', encoding='utf-8') as f:
+            for position in order:
+                f.write(json.dumps({"id": ids[position], "metadata": metadata[position]}) + "\n")
+        with open(os.path.join(version, "settings.json"), 'w', encoding='utf-8') as f:
+            json.dump({"nprobe": nprobe}, f)
+
+        # Repoint the link with an atomic rename: readers see the old version or the new one
+        if os.path.isdir(self.path) and not os.path.islink(self.path):
+            # Index written before versioning: a plain directory cannot be swapped atomically
+            # for a link, so this one migration leaves the path missing for a moment
+            shutil.rmtree(self.path)
+        link = f"{self.path}.link"
+        if os.path.lexists(link):
+            os.unlink(link)
+        os.symlink(os.path.basename(version), link)
+        os.replace(link, self.path)
+
+        self.vectors = None
+        self.remove_versions(keep=version)
+        self.pending = {}
+        self.deleted = set()
+        self.load()
+        logger.info(f"Saved {len(ids)} vectors in {nlist} clusters (nprobe {nprobe}) to {self.path}")
+
+    def remove_versions(self, keep=None):
+        """Removes the version directories of the index other than keep."""
+        for version in glob.glob(f"{glob.escape(os.path.abspath(self.path))}.v*"):
+            if version != keep:
+                # Readers that already mapped an old version keep their open files
+                shutil.rmtree(version, ignore_errors=True)
+
+    def query(self, vector, top_k=5, include_metadata=True, nprobe=None):
+        """
+        Returns the stored vectors most similar to a query vector.
+
+        Args:
+            vector (list): Query embedding
+            top_k (int): Number of matches
+            include_metadata (bool): Attach the stored metadata to each match
+            nprobe (int): Clusters scanned, overriding the index default
+
+        Returns:
+            QueryResult: Matches, best first
+        """
+        if self.vectors is None or not len(self.records):
+            return QueryResult([])
+
+        query = normalize(vector)
+        nlist = len(self.centroids)
+        nprobe = min(nlist, nprobe or self.nprobe or self.default_nprobe or max(1, nlist // 8))
+        if nprobe == nlist:
+            # Flat index, or every cluster probed: one scan of the whole file
+            positions = np.arange(len(self.records))
+            scores = self.vectors @ query
+        else:
+            probes = np.argpartition(-(self.centroids @ query), nprobe - 1)[:nprobe]
+            positions = np.concatenate([np.arange(self.offsets[c], self.offsets[c + 1]) for c in probes])
+            if not len(positions):
+                return QueryResult([])
+            # Probed clusters are scanned as contiguous slices of the memory-mapped file
+            scores = np.concatenate([self.vectors[self.offsets[c]:self.offsets[c + 1]] @ query for c in probes])
+
+        best = exact_top_k(scores, top_k)
+        return QueryResult([
+            QueryMatch(
+                self.records[positions[i]]["id"],
+                float(scores[i]),
+                self.records[positions[i]].get("metadata") if include_metadata else None
+            )
+            for i in best
+        ])
+
+    def brute_force_query(self, vector, top_k=5):
+        """Returns the ids of the exact top_k matches, scanning every vector."""
+        scores = np.asarray(self.vectors) @ normalize(vector)
+        return [self.records[i]["id"] for i in exact_top_k(scores, top_k)]
+
+def choose_nprobe(vectors, centroids, offsets, top_k=5, num_queries=100, noise=0.05, seed=0):
+    """
+    Returns the smallest nprobe whose recall@k against brute force reaches TARGET_RECALL.
+
+    Queries are stored vectors with gaussian noise added, as in benchmark_index().
+
+    Args:
+        vectors (np.ndarray): Unit vectors (N, dim), ordered by cluster
+        centroids (np.ndarray): Cluster centroids (nlist, dim)
+        offsets (np.ndarray): Start of each cluster in vectors, and N
+        top_k (int): k of recall@k
+        num_queries (int): Number of sampled queries
+        noise (float): Standard deviation of the noise added to each query
+        seed (int): Seed of the query sample
+
+    Returns:
+        int: nprobe, 1 for a single cluster
+    """
+    nlist = len(centroids)
+    if nlist == 1:
+        return 1
+    rng = np.random.default_rng(seed)
+    samples = rng.choice(len(vectors), min(num_queries, len(vectors)), replace=False)
+    queries = normalize(vectors[samples] + rng.normal(0, noise, (len(samples), vectors.shape[1])).astype(np.float32))
+    exact = [set(exact_top_k(vectors @ query, top_k)) for query in queries]
+    ranked = [np.argsort(-(centroids @ query)) for query in queries]
+
+    nprobe = 1
+    while nprobe < nlist:
+        found = 0
+        for query, expected, clusters in zip(queries, exact, ranked):
+            positions = np.concatenate([np.arange(offsets[c], offsets[c + 1]) for c in clusters[:nprobe]])
+            if not len(positions):
+                continue
+            found += len(expected & set(positions[exact_top_k(vectors[positions] @ query, top_k)]))
+        if found >= TARGET_RECALL * sum(len(expected) for expected in exact):
+            break
+        nprobe *= 2
+    return min(nprobe, nlist)
+
+def benchmark_index(index, top_k=5, num_queries=200, noise=0.05, nprobes=None, seed=0):
+    """
+    Measures query latency and recall@k of the index against brute force search.
+
+    Queries are stored vectors with gaussian noise added, which keeps them on the
+    distribution of the indexed text without needing the embedding model.
+
+    Args:
+        index (LocalVectorIndex): Saved index
+        top_k (int): k of recall@k
+        num_queries (int): Number of queries
+        noise (float): Standard deviation of the noise added to each query
+        nprobes (list): nprobe values to measure, a range up to all clusters by default
+        seed (int): Seed of the query sample
+
+    Returns:
+        dict: Latency and recall per nprobe, and brute force latency
+    """
+    rng = np.random.default_rng(seed)
+    dim = index.vectors.shape[1]
+    samples = rng.choice(len(index), min(num_queries, len(index)), replace=False)
+    queries = [np.asarray(index.vectors[i]) + rng.normal(0, noise, dim).astype(np.float32) for i in samples]
+
+    exact = []
+    brute_force_seconds = []
+    for query in queries:
+        start = time.perf_counter()
+        exact.append(index.brute_force_query(query, top_k))
+        brute_force_seconds.append(time.perf_counter() - start)
+
+    nlist = len(index.centroids)
+    nprobes = nprobes or sorted({1, max(1, nlist // 16), max(1, nlist // 8), max(1, nlist // 4), max(1, nlist // 2)})
+    results = {
+        "vectors": len(index),
+        "clusters": nlist,
+        "top_k": top_k,
+        "queries": len(queries),
+        "brute_force_ms_p50": statistics.median(brute_force_seconds) * 1000,
+        "nprobe": {},
+    }
+    for nprobe in nprobes:
+        seconds = []
+        recalls = []
+        for query, expected in zip(queries, exact):
+            start = time.perf_counter()
+            matches = index.query(query, top_k=top_k, include_metadata=False, nprobe=nprobe).matches
+            seconds.append(time.perf_counter() - start)
+            recalls.append(len({m.id for m in matches} & set(expected)) / len(expected))
+        seconds.sort()
+        results["nprobe"][nprobe] = {
+            "recall_at_k": statistics.mean(recalls),
+            "latency_ms_p50": statistics.median(seconds) * 1000,
+            "latency_ms_p95": seconds[int(0.95 * (len(seconds) - 1))] * 1000,
+        }
+    logger.info(json.dumps(results, indent=2))
+    return results
+
+def build_synthetic_index(path, num_vectors, dim=384, num_topics=200, seed=0):
+    """Builds an index of clustered random vectors, for benchmarking without a corpus."""
+    rng = np.random.default_rng(seed)
+    topics = normalize(rng.normal(size=(num_topics, dim)))
+    vectors = normalize(topics[rng.integers(num_topics, size=num_vectors)] + rng.normal(0, 0.08, (num_vectors, dim)))
+    index = LocalVectorIndex(path)
+    index.upsert((str(i), vectors[i], {"text": f"chunk {i}"}) for i in range(num_vectors))
+    index.save()
+    return index
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Local vector index")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    benchmark_parser = subparsers.add_parser("benchmark", help="Query latency and recall@k against brute force")
+    benchmark_parser.add_argument("index_dir", nargs="?")
+    benchmark_parser.add_argument("--synthetic", type=int, help="Build a synthetic index of this many vectors instead")
+    benchmark_parser.add_argument("--top-k", type=int, default=5)
+    benchmark_parser.add_argument("--queries", type=int, default=200)
+
+    args = parser.parse_args()
+    if args.synthetic:
+        index = build_synthetic_index(args.index_dir or local_index_path("synthetic-benchmark"), args.synthetic)
+    elif args.index_dir:
+        index = LocalVectorIndex(args.index_dir)
+    else:
+        parser.error("benchmark needs an index directory or --synthetic")
+    benchmark_index(index, args.top_k, args.queries)
@@ -0,0 +1,209 @@
+# merge_adapter.py
+"""
+Folds the LoRA adapter into the base model weights and saves a merged checkpoint.
+
+A merged model runs the plain base architecture: the adapter branches on
+q/k/v/o/gate/up/down_proj no longer run on every forward pass. demo_ssh.py and
+model_server.py load the merged checkpoint directly when MERGED_MODEL_PATH is set.
+
+Usage:
+    python3 merge_adapter.py merge BASE_MODEL_PATH LORA_ADAPTER_PATH OUTPUT_DIR
+    python3 merge_adapter.py benchmark BASE_MODEL_PATH [LORA_ADAPTER_PATH] [--random-adapter]
+
+The benchmark compares tokens per second of merged and unmerged generation on CPU and
+appends the result to BENCHMARK_LOG when it is set. With
+--random-adapter a randomly initialized adapter using the target modules of
+adapter_config.json is applied instead, so a tiny stand-in base model can be used, e.g.
+hf-internal-testing/tiny-random-LlamaForCausalLM.
+"""
+import argparse
+import copy
+import datetime
+import json
+import logging
+import os
+import statistics
+import time
+
+import torch
+from transformers import AutoModelForCausalLM, AutoTokenizer
+from peft import LoraConfig, PeftModel, get_peft_model
+
+from demo_ssh import log_benchmark
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+ADAPTER_CONFIG_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), "adapter_config.json")
+
+BENCHMARK_PROMPT = "<s>[INST] Generate a behavior tree in XML format for a tank platoon patrol. [/INST]"
+
+def merge_adapter(base_model_path, lora_adapter_path, output_dir):
+    """
+    Merges a LoRA adapter into its base model and saves the result.
+
+    Args:
+        base_model_path (str): Base model path or Hugging Face id
+        lora_adapter_path (str): LoRA adapter path
+        output_dir (str): Directory of the merged checkpoint
+
+    Returns:
+        str: output_dir
+    """
+    dtype = torch.float16 if torch.cuda.is_available() else torch.float32
+
+    logger.info("Loading base model...")
+    model = AutoModelForCausalLM.from_pretrained(base_model_path, torch_dtype=dtype, trust_remote_code=True)
+    tokenizer = AutoTokenizer.from_pretrained(base_model_path, trust_remote_code=True)
+
+    logger.info("Loading LoRA adapter...")
+    model = PeftModel.from_pretrained(model, lora_adapter_path, torch_dtype=dtype)
+
+    logger.info("Merging adapter into base weights...")
+    model = model.merge_and_unload()
+
+    os.makedirs(output_dir, exist_ok=True)
+    model.save_pretrained(output_dir, safe_serialization=True)
+    tokenizer.save_pretrained(output_dir)
+
+    merge_info = {
+        "timestamp": datetime.datetime.now().strftime("%Y%m%d_%H%M%S"),
+        "base_model": base_model_path,
+        "lora_adapter": os.path.abspath(lora_adapter_path),
+        "dtype": str(dtype),
+    }
+    with open(os.path.join(output_dir, "merge_info.json"), 'w', encoding='utf-8') as f:
+        json.dump(merge_info, f, indent=2)
+
+    logger.info(f"Merged checkpoint saved to {output_dir}")
+    return output_dir
+
+def make_random_adapter(model):
+    """
+    Wraps a model in a randomly initialized LoRA adapter shaped like adapter_config.json.
+
+    Args:
+        model: Base model
+
+    Returns:
+        PeftModel: Model with a non-zero adapter, so merging changes its weights
+    """
+    with open(ADAPTER_CONFIG_PATH, 'r', encoding='utf-8') as f:
+        adapter_config = json.load(f)
+
+    config = LoraConfig(
+        r=adapter_config["r"],
+        lora_alpha=adapter_config["lora_alpha"],
+        target_modules=adapter_config["target_modules"],
+        lora_dropout=0.0,
+        bias=adapter_config["bias"],
+        task_type=adapter_config["task_type"],
+        init_lora_weights=False,
+    )
+    return get_peft_model(model, config)
+
+def measure_tokens_per_second(model, tokenizer, prompt, new_tokens, runs):
+    """
+    Times greedy generation of exactly new_tokens tokens.
+
+    Args:
+        model: Model to time
+        tokenizer: Matching tokenizer
+        prompt (str): Prompt to generate from
+        new_tokens (int): Number of tokens to generate per run
+        runs (int): Number of timed runs after one warm-up run
+
+    Returns:
+        tuple: (median tokens per second, generated token ids of the last run)
+    """
+    inputs = tokenizer(prompt, return_tensors="pt").to(model.device)
+    generation_kwargs = dict(
+        max_new_tokens=new_tokens,
+        min_new_tokens=new_tokens,
+        do_sample=False,
+        pad_token_id=tokenizer.eos_token_id,
+    )
+
+    with torch.no_grad():
+        model.generate(**inputs, **generation_kwargs)
+
+        rates = []
+        for _ in range(runs):
+            start = time.perf_counter()
+            outputs = model.generate(**inputs, **generation_kwargs)
+            rates.append(new_tokens / (time.perf_counter() - start))
+
+    return statistics.median(rates), outputs[0][inputs.input_ids.shape[-1]:].tolist()
+
+def benchmark_merge(base_model_path, lora_adapter_path=None, random_adapter=False, new_tokens=64, runs=5):
+    """
+    Compares generation speed of the unmerged (PeftModel) and merged model on CPU.
+
+    Args:
+        base_model_path (str): Base model path or Hugging Face id
+        lora_adapter_path (str): LoRA adapter path, unused with random_adapter
+        random_adapter (bool): Use a random adapter shaped like adapter_config.json
+        new_tokens (int): Tokens generated per run
+        runs (int): Timed runs per model
+
+    Returns:
+        dict: Benchmark results
+    """
+    torch.manual_seed(0)
+    tokenizer = AutoTokenizer.from_pretrained(base_model_path, trust_remote_code=True)
+    tokenizer.pad_token = tokenizer.eos_token
+    base = AutoModelForCausalLM.from_pretrained(base_model_path, torch_dtype=torch.float32, trust_remote_code=True)
+
+    if random_adapter:
+        unmerged = make_random_adapter(base)
+    else:
+        unmerged = PeftModel.from_pretrained(base, lora_adapter_path, torch_dtype=torch.float32)
+    unmerged.eval()
+
+    # Merge a copy so both models stay available for the comparison
+    merged = copy.deepcopy(unmerged).merge_and_unload()
+    merged.eval()
+
+    unmerged_rate, unmerged_tokens = measure_tokens_per_second(unmerged, tokenizer, BENCHMARK_PROMPT, new_tokens, runs)
+    merged_rate, merged_tokens = measure_tokens_per_second(merged, tokenizer, BENCHMARK_PROMPT, new_tokens, runs)
+
+    results = {
+        "base_model": base_model_path,
+        "adapter": "random" if random_adapter else lora_adapter_path,
+        "new_tokens": new_tokens,
+        "runs": runs,
+        "unmerged_tokens_per_second": unmerged_rate,
+        "merged_tokens_per_second": merged_rate,
+        "speedup": merged_rate / unmerged_rate,
+        "identical_greedy_output": unmerged_tokens == merged_tokens,
+    }
+    log_benchmark(
+        f"merge_adapter: merged {merged_rate:.1f} tokens/s, unmerged {unmerged_rate:.1f} tokens/s, "
+        f"speedup {results['speedup']:.2f}x over {runs} runs of {new_tokens} tokens"
+    )
+    logger.info(json.dumps(results, indent=2))
+    return results
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Merge the LoRA adapter into the base model")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    merge_parser = subparsers.add_parser("merge", help="Merge and save a checkpoint")
+    merge_parser.add_argument("base_model")
+    merge_parser.add_argument("lora_adapter")
+    merge_parser.add_argument("output_dir")
+
+    benchmark_parser = subparsers.add_parser("benchmark", help="Compare merged and unmerged tokens/sec")
+    benchmark_parser.add_argument("base_model")
+    benchmark_parser.add_argument("lora_adapter", nargs="?")
+    benchmark_parser.add_argument("--random-adapter", action="store_true")
+    benchmark_parser.add_argument("--new-tokens", type=int, default=64)
+    benchmark_parser.add_argument("--runs", type=int, default=5)
+
+    args = parser.parse_args()
+    if args.command == "merge":
+        merge_adapter(args.base_model, args.lora_adapter, args.output_dir)
+    else:
+        if not args.random_adapter and not args.lora_adapter:
+            parser.error("benchmark needs a LoRA adapter path or --random-adapter")
+        benchmark_merge(args.base_model, args.lora_adapter, args.random_adapter, args.new_tokens, args.runs)
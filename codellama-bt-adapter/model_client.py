@@ -0,0 +1,131 @@
+# model_client.py
+"""
+Thin client for model_server.py.
+
+Sends a scenarios file to a running generation server and prints the generated files.
+The server writes the outputs directly to output_dir, which must be on a filesystem it
+can reach (e.g. the shared cluster filesystem) and under the server's output root.
+Requests are authenticated with the token the server wrote to its token file.
+
+Usage:
+    python3 model_client.py scenarios.json output_dir [--server http://host:8100] [--token-file model_server.token]
+    python3 model_client.py --check [--server http://host:8100]
+"""
+import argparse
+import json
+import logging
+import os
+import sys
+import time
+import urllib.error
+import urllib.request
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+def load_scenarios(scenarios_file):
+    """Reads the scenarios list of a scenarios file. Kept here so the client does not need torch."""
+    with open(scenarios_file, 'r', encoding='utf-8') as f:
+        return json.load(f)["scenarios"]
+
+def read_token(token_file):
+    """Reads the access token written by model_server.py."""
+    with open(token_file, 'r', encoding='utf-8') as f:
+        return f.read().strip()
+
+def request_json(url, payload=None, timeout=10, token=None):
+    """
+    Sends a GET (or a POST when payload is given) and decodes the JSON response.
+
+    Args:
+        url (str): Endpoint URL
+        payload (dict): JSON body to POST
+        timeout (float): Timeout in seconds
+        token (str): Access token of the server, sent as a Bearer token
+
+    Returns:
+        dict: Decoded response
+    """
+    data = json.dumps(payload).encode('utf-8') if payload is not None else None
+    headers = {"Content-Type": "application/json"}
+    if token:
+        headers["Authorization"] = f"Bearer {token}"
+    request = urllib.request.Request(url, data=data, headers=headers)
+    with urllib.request.urlopen(request, timeout=timeout) as response:
+        return json.loads(response.read().decode('utf-8'))
+
+def server_is_ready(server_url):
+    """Returns True if the server answers and has its model loaded."""
+    try:
+        return request_json(f"{server_url}/health", timeout=5).get("model_loaded", False)
+    except (urllib.error.URLError, OSError, ValueError):
+        return False
+
+def log_benchmark(message):
+    """Appends a line to BENCHMARK_LOG when it is set."""
+    benchmark_log = os.getenv('BENCHMARK_LOG')
+    if benchmark_log:
+        with open(benchmark_log, 'a', encoding='utf-8') as f:
+            f.write(message + '\n')
+
+def submit_scenarios(server_url, scenarios_file, output_dir, token, timeout=3600):
+    """
+    Sends every scenario of a scenarios file to the server.
+
+    Args:
+        server_url (str): Server URL, e.g. http://host:8100
+        scenarios_file (str): Path to the scenarios JSON file
+        output_dir (str): Root of the xml/ and metadata/ output directories
+        token (str): Access token of the server
+        timeout (float): Timeout of the generation request in seconds
+
+    Returns:
+        list: Paths of the generated XML files
+    """
+    start = time.time()
+    result = request_json(
+        f"{server_url}/generate",
+        {"scenarios": load_scenarios(scenarios_file), "output_dir": os.path.abspath(output_dir)},
+        timeout=timeout,
+        token=token
+    )
+    elapsed = time.time() - start
+
+    metrics = request_json(f"{server_url}/metrics", token=token)
+    log_benchmark(
+        f"model_server request: {len(result['files'])} scenarios in {elapsed:.2f}s "
+        f"(queue wait {result['timings']['queue_wait_seconds']:.2f}s, "
+        f"server model load {metrics['model_load_seconds']:.2f}s paid once, "
+        f"requests served {metrics['requests_served']})"
+    )
+    return result["files"]
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Behavior tree generation client")
+    parser.add_argument("scenarios_file", nargs="?")
+    parser.add_argument("output_dir", nargs="?")
+    parser.add_argument("--server", default=os.getenv('MODEL_SERVER_URL', "http://localhost:8100"))
+    parser.add_argument("--token-file", default=os.getenv('MODEL_SERVER_TOKEN_FILE', "model_server.token"),
+                        help="Token file written by model_server.py")
+    parser.add_argument("--check", action="store_true", help="Exit with 0 if the server is ready, 1 otherwise")
+    args = parser.parse_args()
+
+    if args.check:
+        sys.exit(0 if server_is_ready(args.server) else 1)
+
+    if not args.scenarios_file or not args.output_dir:
+        print("Usage: python model_client.py scenarios.json output_dir [--server URL]")
+        sys.exit(1)
+
+    if not os.path.exists(args.scenarios_file):
+        print(f"Error: Scenarios file '{args.scenarios_file}' not found")
+        sys.exit(1)
+
+    try:
+        generated_files = submit_scenarios(args.server, args.scenarios_file, args.output_dir, read_token(args.token_file))
+        print(f"\nGenerated {len(generated_files)} behavior trees:")
+        for file in generated_files:
+            print(f"- {file}")
+    except Exception as e:
+        print(f"Error: {str(e)}")
+        sys.exit(1)
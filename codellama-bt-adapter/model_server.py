@@ -0,0 +1,356 @@
+# model_server.py
+"""
+Long-lived behavior tree generation server.
+
+Loads the base model and LoRA adapter once and serves scenarios over HTTP, so that
+jobs no longer pay the model load on every run. Outputs are written to the xml/ and
+metadata/ directories of the requested output directory, exactly as demo_ssh.py does.
+Output directories must lie under the output root given at startup.
+
+Every request except /health must carry the token the server writes to its token file
+(mode 0600, model_server.token next to the address file by default) as a Bearer token.
+
+Usage:
+    python3 model_server.py --port 8100 --address-file ../model_server.addr --output-root runs
+
+Testing on CPU with a tiny stand-in model and no Pinecone access:
+    python3 model_server.py --base-model hf-internal-testing/tiny-random-LlamaForCausalLM \
+        --no-adapter --no-rag --max-new-tokens 32 --token-file /tmp/model_server.token
+"""
+import argparse
+import hmac
+import logging
+import os
+import secrets
+import socket
+import threading
+import time
+from typing import List, Optional
+
+import torch
+import uvicorn
+from dotenv import load_dotenv
+from fastapi import Depends, FastAPI, Header, HTTPException
+from pydantic import BaseModel
+from transformers import LogitsProcessorList
+
+from demo_ssh import (
+    build_prompt,
+    default_max_new_tokens,
+    initialize_model,
+    retrieve_scenario_context,
+    save_behavior_tree,
+)
+from prefix_cache import PromptPrefixCache
+from xml_grammar import BehaviorTreeGrammar, BehaviorTreeLogitsProcessor
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_OUTPUT_ROOT = os.path.join(SCRIPT_DIR, "runs")
+
+class Scenario(BaseModel):
+    name: str
+    prompt: str
+
+class GenerateRequest(BaseModel):
+    scenarios: List[Scenario]
+    output_dir: str
+    max_new_tokens: Optional[int] = None
+    temperature: float = 0.7
+    top_p: float = 0.95
+
+class ModelServer:
+    """
+    Holds the loaded model and serializes generation requests.
+
+    Args:
+        base_model_path (str): Base model path or Hugging Face id
+        lora_adapter_path (str): LoRA adapter path, or None to serve the base model alone
+        merged_model_path (str): Merged checkpoint from merge_adapter.py, used instead of the
+            base model and adapter when given
+        use_rag (bool): Retrieve doctrine context for each scenario
+        max_new_tokens (int): Default token limit per scenario, or None for
+            default_max_new_tokens()
+        use_prefix_cache (bool): Reuse the KV cache of the shared prompt prefix across requests
+        use_grammar (bool): Constrain generation to the behavior tree XML grammar
+    """
+
+    def __init__(self, base_model_path, lora_adapter_path=None, use_rag=True, max_new_tokens=None, merged_model_path=None, use_prefix_cache=True, use_grammar=True):
+        self.base_model_path = base_model_path
+        self.lora_adapter_path = lora_adapter_path
+        self.merged_model_path = merged_model_path
+        self.use_rag = use_rag
+        self.max_new_tokens = max_new_tokens or default_max_new_tokens(use_grammar)
+        self.use_prefix_cache = use_prefix_cache
+        self.use_grammar = use_grammar
+        self.model = None
+        self.tokenizer = None
+        self.prefix_cache = None
+        self.grammar_processor = None
+        self.lock = threading.Lock()
+        self.process_start = time.time()
+        self.metrics = {
+            "model_load_seconds": None,
+            "startup_seconds": None,
+            "requests_served": 0,
+            "scenarios_served": 0,
+            "first_request_seconds": None,
+            "last_request_seconds": None,
+            "total_request_seconds": 0.0,
+            "total_generation_seconds": 0.0,
+            "total_queue_wait_seconds": 0.0,
+            "generated_tokens": 0,
+        }
+
+    def load(self):
+        """Loads the model and tokenizer, recording the cold start cost."""
+        start = time.time()
+        self.model, self.tokenizer = initialize_model(self.base_model_path, self.lora_adapter_path, self.merged_model_path)
+        if self.use_prefix_cache:
+            self.prefix_cache = PromptPrefixCache(self.model, self.tokenizer)
+        if self.use_grammar:
+            self.grammar_processor = BehaviorTreeLogitsProcessor(BehaviorTreeGrammar(), self.tokenizer)
+        self.metrics["model_load_seconds"] = time.time() - start
+        self.metrics["startup_seconds"] = time.time() - self.process_start
+        logger.info(f"Model loaded in {self.metrics['model_load_seconds']:.2f}s")
+
+    def generate(self, request, output_dir):
+        """
+        Generates a behavior tree for every scenario of a request.
+
+        Args:
+            request (GenerateRequest): Scenarios and generation settings
+            output_dir (str): Output directory of the request, checked by resolve_output_dir()
+
+        Returns:
+            dict: Generated files and the timings of the request
+        """
+        received = time.time()
+        max_new_tokens = request.max_new_tokens or self.max_new_tokens
+        files = []
+        scenario_timings = []
+
+        with self.lock:
+            queue_wait = time.time() - received
+            for scenario in request.scenarios:
+                scenario_start = time.time()
+                context, context_chunks = retrieve_scenario_context(scenario.prompt, self.use_rag)
+                inputs = self.tokenizer(build_prompt(scenario.prompt, context), return_tensors="pt").to(self.model.device)
+
+                generation_kwargs = {}
+                if self.prefix_cache is not None:
+                    past_key_values = self.prefix_cache.cache_for(inputs.input_ids)
+                    if past_key_values is not None:
+                        generation_kwargs["past_key_values"] = past_key_values
+                if self.grammar_processor is not None:
+                    self.grammar_processor.prepare(max_new_tokens)
+                    generation_kwargs["logits_processor"] = LogitsProcessorList([self.grammar_processor])
+
+                generation_start = time.time()
+                with torch.no_grad():
+                    outputs = self.model.generate(
+                        **inputs,
+                        **generation_kwargs,
+                        max_new_tokens=max_new_tokens,
+                        temperature=request.temperature,
+                        top_p=request.top_p,
+                        pad_token_id=self.tokenizer.eos_token_id
+                    )
+                generation_seconds = time.time() - generation_start
+                new_tokens = outputs.shape[-1] - inputs.input_ids.shape[-1]
+
+                response = self.tokenizer.decode(outputs[0][inputs.input_ids.shape[-1]:], skip_special_tokens=True)
+                timings = {
+                    "generation_seconds": generation_seconds,
+                    "scenario_seconds": time.time() - scenario_start,
+                    "new_tokens": int(new_tokens),
+                }
+                files.append(save_behavior_tree(
+                    response,
+                    scenario.name,
+                    scenario.prompt,
+                    context,
+                    context_chunks,
+                    output_dir,
+                    {
+                        "max_new_tokens": max_new_tokens,
+                        "temperature": request.temperature,
+                        "top_p": request.top_p,
+                        "constrained_decoding": self.grammar_processor is not None,
+                        "budget_forced_close": self.grammar_processor is not None and self.grammar_processor.was_budget_forced()
+                    },
+                    {"server_timings": timings}
+                ))
+                scenario_timings.append({"scenario": scenario.name, **timings})
+                self.metrics["total_generation_seconds"] += generation_seconds
+                self.metrics["generated_tokens"] += int(new_tokens)
+
+            request_seconds = time.time() - received
+            self.metrics["requests_served"] += 1
+            self.metrics["scenarios_served"] += len(request.scenarios)
+            self.metrics["total_request_seconds"] += request_seconds
+            self.metrics["total_queue_wait_seconds"] += queue_wait
+            self.metrics["last_request_seconds"] = request_seconds
+            if self.metrics["first_request_seconds"] is None:
+                self.metrics["first_request_seconds"] = request_seconds
+
+        return {
+            "files": files,
+            "timings": {
+                "queue_wait_seconds": queue_wait,
+                "request_seconds": request_seconds,
+                "scenarios": scenario_timings,
+            }
+        }
+
+    def get_metrics(self):
+        """Returns the warm-start metrics of the server."""
+        metrics = dict(self.metrics)
+        requests = metrics["requests_served"]
+        metrics["uptime_seconds"] = time.time() - self.process_start
+        metrics["prefix_cache"] = self.prefix_cache.get_stats() if self.prefix_cache is not None else None
+        metrics["mean_request_seconds"] = metrics["total_request_seconds"] / requests if requests else None
+        metrics["tokens_per_second"] = (
+            metrics["generated_tokens"] / metrics["total_generation_seconds"]
+            if metrics["total_generation_seconds"] > 0 else None
+        )
+        # Model load time saved by every request after the first one
+        metrics["load_seconds_saved"] = (
+            metrics["model_load_seconds"] * max(requests - 1, 0)
+            if metrics["model_load_seconds"] is not None else None
+        )
+        return metrics
+
+def resolve_output_dir(output_root, output_dir):
+    """
+    Resolves a requested output directory and checks that it lies under the output root.
+
+    Args:
+        output_root (str): Directory under which the server may write, fixed at startup
+        output_dir (str): Requested output directory
+
+    Returns:
+        str: The resolved output directory
+
+    Raises:
+        ValueError: If the directory resolves to a path outside the output root
+    """
+    root = os.path.realpath(output_root)
+    resolved = os.path.realpath(output_dir)
+    if os.path.commonpath([root, resolved]) != root:
+        raise ValueError(f"Output directory '{output_dir}' is outside the output root")
+    return resolved
+
+def write_token_file(token_file):
+    """
+    Creates a new access token and writes it to a file only the job user can read.
+
+    Args:
+        token_file (str): Path of the token file
+
+    Returns:
+        str: The token
+    """
+    token = secrets.token_urlsafe(32)
+    if os.path.exists(token_file):
+        os.remove(token_file)
+    fd = os.open(token_file, os.O_WRONLY | os.O_CREAT | os.O_EXCL, 0o600)
+    with os.fdopen(fd, 'w', encoding='utf-8') as f:
+        f.write(token + '\n')
+    return token
+
+def create_app(server, token, output_root):
+    """
+    Creates the HTTP API of a loaded ModelServer.
+
+    Args:
+        server (ModelServer): Server holding the loaded model
+        token (str): Bearer token required by every endpoint except /health
+        output_root (str): Directory under which requests may write their outputs
+
+    Returns:
+        FastAPI: The application
+    """
+    app = FastAPI()
+
+    def check_token(authorization: Optional[str] = Header(None)):
+        expected = f"Bearer {token}"
+        if authorization is None or not hmac.compare_digest(authorization.encode('utf-8'), expected.encode('utf-8')):
+            raise HTTPException(status_code=401, detail="Invalid or missing token")
+
+    @app.get("/health")
+    def health():
+        return {"status": "ok", "model_loaded": server.model is not None}
+
+    @app.get("/metrics", dependencies=[Depends(check_token)])
+    def metrics():
+        return server.get_metrics()
+
+    @app.post("/generate", dependencies=[Depends(check_token)])
+    def generate(request: GenerateRequest):
+        if server.model is None:
+            raise HTTPException(status_code=503, detail="Model not loaded")
+        try:
+            output_dir = resolve_output_dir(output_root, request.output_dir)
+        except ValueError as e:
+            raise HTTPException(status_code=403, detail=str(e))
+        try:
+            return server.generate(request, output_dir)
+        except Exception as e:
+            logger.error(f"Error generating behavior trees: {str(e)}")
+            raise HTTPException(status_code=500, detail=str(e))
+
+    return app
+
+def parse_args():
+    load_dotenv()
+    parser = argparse.ArgumentParser(description="Behavior tree generation server")
+    parser.add_argument("--base-model", default=os.getenv('BASE_MODEL_PATH'), help="Base model path or Hugging Face id")
+    parser.add_argument("--adapter", default=os.getenv('LORA_ADAPTER_PATH'), help="LoRA adapter path")
+    parser.add_argument("--no-adapter", action="store_true", help="Serve the base model without the LoRA adapter")
+    parser.add_argument("--merged-model", default=os.getenv('MERGED_MODEL_PATH'), help="Merged checkpoint from merge_adapter.py")
+    parser.add_argument("--no-rag", action="store_true", help="Do not retrieve context from Pinecone")
+    parser.add_argument("--no-prefix-cache", action="store_true", help="Prefill the whole prompt for every scenario")
+    parser.add_argument("--no-grammar", action="store_true", help="Do not constrain generation to the behavior tree grammar")
+    parser.add_argument("--max-new-tokens", type=int, default=None, help="Default token limit per scenario (512)")
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8100)
+    parser.add_argument("--address-file", help="File to write the server URL to once the model is loaded")
+    parser.add_argument("--token-file", help="File to write the access token to (default: model_server.token next to the address file)")
+    parser.add_argument("--output-root", default=os.getenv('MODEL_SERVER_OUTPUT_ROOT', DEFAULT_OUTPUT_ROOT),
+                        help="Directory under which requests may write their outputs")
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    args = parse_args()
+    if not args.base_model and not args.merged_model:
+        print("Error: no base model given (--base-model or BASE_MODEL_PATH)")
+        raise SystemExit(1)
+
+    token_file = args.token_file
+    if not token_file and args.address_file:
+        token_file = os.path.join(os.path.dirname(os.path.abspath(args.address_file)), "model_server.token")
+    if not token_file:
+        print("Error: no token file given (--token-file or --address-file)")
+        raise SystemExit(1)
+
+    server = ModelServer(
+        args.base_model,
+        None if args.no_adapter else args.adapter,
+        use_rag=not args.no_rag,
+        max_new_tokens=args.max_new_tokens,
+        merged_model_path=args.merged_model,
+        use_prefix_cache=not args.no_prefix_cache,
+        use_grammar=not args.no_grammar
+    )
+    server.load()
+
+    # The token is in place before the address file tells clients where to connect
+    token = write_token_file(token_file)
+    if args.address_file:
+        with open(args.address_file, 'w', encoding='utf-8') as f:
+            f.write(f"http://{socket.gethostname()}:{args.port}\n")
+
+    uvicorn.run(create_app(server, token, args.output_root), host=args.host, port=args.port)
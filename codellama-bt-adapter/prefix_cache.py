@@ -0,0 +1,217 @@
+# prefix_cache.py
+"""
+KV cache of the prompt prefix shared by every scenario.
+
+Every prompt starts with the same system message and node type catalogue; only the
+retrieved context and the scenario text differ. PromptPrefixCache prefills that prefix
+once and hands a copy of its KV cache to model.generate for each scenario, so prefill
+is only paid for the scenario specific part of the prompt.
+
+Usage:
+    python3 prefix_cache.py benchmark scenarios.json [--base-model PATH] [--adapter PATH] [--no-rag]
+
+The benchmark times the prefill of every scenario prompt with and without the cached
+prefix and appends the result to BENCHMARK_LOG when it is set.
+"""
+import argparse
+import copy
+import json
+import logging
+import os
+import statistics
+import time
+
+import torch
+from dotenv import load_dotenv
+from transformers import DynamicCache
+
+from demo_ssh import (
+    build_prompt,
+    build_prompt_prefix,
+    initialize_model,
+    load_scenarios,
+    log_benchmark,
+    retrieve_scenario_context,
+)
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+class PromptPrefixCache:
+    """
+    Prefilled KV cache of the shared prompt prefix.
+
+    Args:
+        model: Loaded model
+        tokenizer: Tokenizer matching model
+        prefix_text (str): Prefix to cache, build_prompt_prefix() by default
+    """
+
+    def __init__(self, model, tokenizer, prefix_text=None):
+        self.model = model
+        self.tokenizer = tokenizer
+        self.prefix_text = prefix_text if prefix_text is not None else build_prompt_prefix()
+        self.prefix_ids = tokenizer(self.prefix_text, return_tensors="pt").input_ids.to(model.device)
+        self.hits = 0
+        self.misses = 0
+        self.reused_tokens = 0
+
+        start = time.time()
+        self.cache = DynamicCache()
+        with torch.no_grad():
+            model(input_ids=self.prefix_ids, past_key_values=self.cache, use_cache=True)
+        self.build_seconds = time.time() - start
+        logger.info(f"Cached {self.prefix_ids.shape[-1]} prefix tokens in {self.build_seconds:.2f}s")
+
+    def matched_length(self, input_ids):
+        """
+        Returns the number of leading tokens of a prompt covered by the cached prefix.
+
+        Tokenization may merge tokens across the end of the prefix, so the prompt is
+        compared token by token rather than assumed to start with prefix_ids. At least one
+        prompt token is always left uncached for generate to prefill.
+
+        Args:
+            input_ids (torch.Tensor): Prompt token ids of shape (1, length)
+
+        Returns:
+            int: Number of reusable prefix tokens
+        """
+        length = min(self.prefix_ids.shape[-1], input_ids.shape[-1] - 1)
+        if length <= 0:
+            return 0
+        mismatches = (self.prefix_ids[0, :length] != input_ids[0, :length].to(self.prefix_ids.device)).nonzero()
+        return length if mismatches.numel() == 0 else int(mismatches[0, 0])
+
+    def cache_for(self, input_ids):
+        """
+        Returns a copy of the prefix cache for a prompt, cropped to the tokens it shares.
+
+        generate extends the cache it is given, so every prompt gets its own copy.
+
+        Args:
+            input_ids (torch.Tensor): Prompt token ids of shape (1, length)
+
+        Returns:
+            DynamicCache: Cache to pass as past_key_values, or None if nothing is shared
+        """
+        length = self.matched_length(input_ids)
+        if length == 0:
+            self.misses += 1
+            return None
+
+        cache = copy.deepcopy(self.cache)
+        if length < cache.get_seq_length():
+            cache.crop(length)
+        self.hits += 1
+        self.reused_tokens += length
+        return cache
+
+    def get_stats(self):
+        """Returns the prefix length, build time and reuse counters."""
+        return {
+            "prefix_tokens": int(self.prefix_ids.shape[-1]),
+            "build_seconds": self.build_seconds,
+            "hits": self.hits,
+            "misses": self.misses,
+            "reused_tokens": self.reused_tokens,
+        }
+
+def time_prefill(model, input_ids, past_key_values=None):
+    """
+    Times a single forward pass over the uncached part of a prompt.
+
+    Args:
+        model: Loaded model
+        input_ids (torch.Tensor): Full prompt token ids of shape (1, length)
+        past_key_values (DynamicCache): Cache of the leading tokens, or None
+
+    Returns:
+        float: Prefill time in seconds
+    """
+    cached = past_key_values.get_seq_length() if past_key_values is not None else 0
+    if torch.cuda.is_available():
+        torch.cuda.synchronize()
+    start = time.perf_counter()
+    with torch.no_grad():
+        model(input_ids=input_ids[:, cached:], past_key_values=past_key_values, use_cache=True)
+    if torch.cuda.is_available():
+        torch.cuda.synchronize()
+    return time.perf_counter() - start
+
+def benchmark_prefill(model, tokenizer, scenarios, use_rag=True, runs=3):
+    """
+    Compares prefill time of every scenario prompt with and without the cached prefix.
+
+    Args:
+        model: Loaded model
+        tokenizer: Tokenizer matching model
+        scenarios (list): Scenario dicts with "name" and "prompt"
+        use_rag (bool): Include the retrieved context in the prompts
+        runs (int): Timed runs per prompt, the median is kept
+
+    Returns:
+        dict: Benchmark results
+    """
+    prefix_cache = PromptPrefixCache(model, tokenizer)
+    prompts = []
+    for scenario in scenarios:
+        context, _ = retrieve_scenario_context(scenario["prompt"], use_rag)
+        prompts.append(tokenizer(build_prompt(scenario["prompt"], context), return_tensors="pt").input_ids.to(model.device))
+
+    # Warm up kernels before timing
+    time_prefill(model, prompts[0])
+
+    full_seconds = []
+    cached_seconds = []
+    for input_ids in prompts:
+        full_seconds.append(statistics.median(time_prefill(model, input_ids) for _ in range(runs)))
+        # The cache copy is part of the cost of reusing the prefix
+        cached_runs = []
+        for _ in range(runs):
+            start = time.perf_counter()
+            past_key_values = prefix_cache.cache_for(input_ids)
+            copy_seconds = time.perf_counter() - start
+            cached_runs.append(copy_seconds + time_prefill(model, input_ids, past_key_values))
+        cached_seconds.append(statistics.median(cached_runs))
+
+    results = {
+        "scenarios": len(prompts),
+        "prefix_tokens": int(prefix_cache.prefix_ids.shape[-1]),
+        "mean_prompt_tokens": statistics.mean(int(p.shape[-1]) for p in prompts),
+        "prefix_build_seconds": prefix_cache.build_seconds,
+        "mean_full_prefill_seconds": statistics.mean(full_seconds),
+        "mean_cached_prefill_seconds": statistics.mean(cached_seconds),
+    }
+    results["prefill_seconds_saved_per_scenario"] = results["mean_full_prefill_seconds"] - results["mean_cached_prefill_seconds"]
+    results["prefill_speedup"] = results["mean_full_prefill_seconds"] / results["mean_cached_prefill_seconds"]
+
+    logger.info(json.dumps(results, indent=2))
+    log_benchmark(
+        f"prefix cache: {results['prefix_tokens']} of ~{results['mean_prompt_tokens']:.0f} prompt tokens cached, "
+        f"prefill {results['mean_full_prefill_seconds'] * 1000:.1f}ms -> {results['mean_cached_prefill_seconds'] * 1000:.1f}ms "
+        f"per scenario ({results['prefill_speedup']:.2f}x)"
+    )
+    return results
+
+if __name__ == "__main__":
+    load_dotenv()
+    parser = argparse.ArgumentParser(description="Prompt prefix KV cache")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    benchmark_parser = subparsers.add_parser("benchmark", help="Compare prefill time with and without the cached prefix")
+    benchmark_parser.add_argument("scenarios_file")
+    benchmark_parser.add_argument("--base-model", default=os.getenv('BASE_MODEL_PATH'))
+    benchmark_parser.add_argument("--adapter", default=os.getenv('LORA_ADAPTER_PATH'))
+    benchmark_parser.add_argument("--merged-model", default=os.getenv('MERGED_MODEL_PATH'))
+    benchmark_parser.add_argument("--no-adapter", action="store_true")
+    benchmark_parser.add_argument("--no-rag", action="store_true")
+    benchmark_parser.add_argument("--runs", type=int, default=3)
+
+    args = parser.parse_args()
+    model, tokenizer = initialize_model(
+        args.base_model,
+        None if args.no_adapter else args.adapter,
+        args.merged_model
+    )
+    benchmark_prefill(model, tokenizer, load_scenarios(args.scenarios_file), use_rag=not args.no_rag, runs=args.runs)
@@ -1,26 +1,49 @@
-from sentence_transformers import SentenceTransformer
-from pinecone import Pinecone
 import os
 from dotenv import load_dotenv
 
+from embedding_service import embed_query
+from local_index import LocalVectorIndex, local_index_path
+
 load_dotenv()
 
-# Initialize Pinecone with your API key
-pc = Pinecone(api_key=os.getenv('PINECONE_API_KEY'))
-model = SentenceTransformer('all-MiniLM-L6-v2')
+# Pinecone client and opened local indexes, created on first use
+pc = None
+local_indexes = {}
 
 def get_text_embedding(text_query):
-    # Use Sentence Transformers to get the embedding
-    return model.encode(text_query).tolist()  # Convert to list for compatibility
+    # Shared Sentence Transformers model, with embeddings cached by content hash
+    return embed_query(text_query)
+
+def get_index(index_name):
+    """
+    Returns the index to query: the local index built by upsert_document.py when it exists
+    (no network round-trip), otherwise the Pinecone index of the same name. An opened local
+    index is reloaded when a re-ingest has replaced it, so long-lived processes such as
+    model_server.py do not keep answering from the old version.
+    """
+    global pc
+    path = local_index_path(index_name)
+    if os.path.exists(os.path.join(path, "records.jsonl")):
+        if index_name not in local_indexes:
+            local_indexes[index_name] = LocalVectorIndex(path)
+        else:
+            local_indexes[index_name].reload_if_replaced()
+        return local_indexes[index_name]
+
+    if pc is None:
+        from pinecone import Pinecone
+        # Initialize Pinecone with your API key
+        pc = Pinecone(api_key=os.getenv('PINECONE_API_KEY'))
+    return pc.Index(index_name)
 
 def retrieve_similar_content(query, index_name, top_k=5):
     # Generate query embedding
     query_embedding = get_text_embedding(query)
 
-    # Connect to Pinecone index
-    index = pc.Index(index_name)
+    # Connect to the local or Pinecone index
+    index = get_index(index_name)
 
-    # Query Pinecone for similar vectors
+    # Query for similar vectors
     results = index.query(vector=query_embedding, top_k=top_k, include_metadata=True)
 
     return results
@@ -0,0 +1,286 @@
+# speculative.py
+"""
+Speculative decoding for behavior tree generation.
+
+Two drafters are supported through Hugging Face assisted generation:
+    - "prompt_lookup": drafts the tokens that followed an earlier occurrence of the last
+      few tokens (n-gram lookup in the prompt and the tree generated so far). Closing tags
+      and repeated attribute patterns are drafted without running any model.
+    - "draft": a small draft model sharing the tokenizer of the target model
+      (e.g. a 1B Llama / TinyLlama for CodeLlama-7B).
+
+The target model verifies every drafted token, so greedy output is unchanged.
+
+Usage:
+    python3 speculative.py benchmark TARGET_MODEL [--draft-model DRAFT_MODEL] [--scenarios FILE]
+
+The benchmark runs greedy generation on CPU with and without each drafter, reporting the
+acceptance rate of the drafted tokens and the end-to-end speedup, e.g. with the stand-in
+models JackFram/llama-160m (target) and JackFram/llama-68m (draft).
+"""
+import argparse
+import json
+import logging
+import os
+import statistics
+import time
+
+import torch
+from dotenv import load_dotenv
+from transformers import AutoModelForCausalLM, AutoTokenizer
+
+from demo_ssh import build_prompt, load_scenarios, log_benchmark
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+def load_draft_model(draft_model_path):
+    """
+    Loads a draft model on the same device and dtype as demo_ssh.initialize_model.
+
+    Args:
+        draft_model_path (str): Draft model path or Hugging Face id
+
+    Returns:
+        model: Draft model in eval mode
+    """
+    draft_model = AutoModelForCausalLM.from_pretrained(
+        draft_model_path,
+        torch_dtype=torch.float16 if torch.cuda.is_available() else torch.float32,
+        device_map="auto" if torch.cuda.is_available() else None,
+        trust_remote_code=True
+    )
+    draft_model.eval()
+    return draft_model
+
+def speculative_kwargs(mode, draft_model=None, num_tokens=10):
+    """
+    Returns the model.generate arguments enabling a speculative decoding mode.
+
+    Args:
+        mode (str): "prompt_lookup", "draft" or None
+        draft_model: Draft model, required for "draft"
+        num_tokens (int): Tokens drafted per step by prompt lookup
+
+    Returns:
+        dict: Extra generate arguments
+    """
+    if not mode:
+        return {}
+    if mode == "prompt_lookup":
+        return {"prompt_lookup_num_tokens": num_tokens}
+    if mode == "draft":
+        if draft_model is None:
+            raise ValueError("Speculative mode 'draft' needs a draft model")
+        return {"assistant_model": draft_model}
+    raise ValueError(f"Unknown speculative mode: {mode}")
+
+def prompt_lookup_draft(tokens, num_tokens=10, max_ngram=2):
+    """
+    Drafts the continuation of a sequence by n-gram lookup in the sequence itself, with the
+    same search as the Hugging Face prompt lookup candidate generator.
+
+    Args:
+        tokens (list): Token ids so far (prompt and generated)
+        num_tokens (int): Maximum number of tokens drafted
+        max_ngram (int): Longest n-gram matched
+
+    Returns:
+        list: Drafted token ids, empty when no n-gram matches
+    """
+    for ngram in range(min(max_ngram, len(tokens) - 1), 0, -1):
+        pattern = tokens[-ngram:]
+        for start in range(len(tokens) - ngram):
+            if tokens[start:start + ngram] == pattern:
+                draft = tokens[start + ngram:start + ngram + num_tokens]
+                if draft:
+                    return draft
+    return []
+
+def draft_model_draft(draft_model, tokens, num_tokens=5):
+    """
+    Drafts the continuation of a sequence greedily with the draft model.
+
+    Args:
+        draft_model: Draft model
+        tokens (list): Token ids so far (prompt and generated)
+        num_tokens (int): Number of tokens drafted
+
+    Returns:
+        list: Drafted token ids
+    """
+    input_ids = torch.tensor([tokens], device=draft_model.device)
+    with torch.no_grad():
+        outputs = draft_model.generate(
+            input_ids,
+            attention_mask=torch.ones_like(input_ids),
+            max_new_tokens=num_tokens,
+            do_sample=False
+        )
+    return outputs[0, len(tokens):].tolist()
+
+def measure_acceptance(prompt_tokens, target_tokens, drafter):
+    """
+    Replays greedy speculative decoding of a known greedy output to count accepted drafts.
+
+    With greedy verification the target output does not depend on the drafter, so each
+    round accepts the longest drafted prefix matching the target output, followed by one
+    token from the target model itself. The draft length is fixed here, whereas assisted
+    generation adapts the number of draft model tokens to the acceptance so far.
+
+    Args:
+        prompt_tokens (list): Prompt token ids
+        target_tokens (list): Greedy output of the target model
+        drafter (callable): Token ids so far -> drafted token ids
+
+    Returns:
+        dict: Drafted and accepted tokens, acceptance rate, verification steps and the
+            mean number of tokens produced per target forward pass
+    """
+    drafted = 0
+    accepted = 0
+    steps = 0
+    position = 0
+    while position < len(target_tokens):
+        draft = drafter(prompt_tokens + target_tokens[:position])
+        matched = 0
+        while matched < len(draft) and position + matched < len(target_tokens) \
+                and draft[matched] == target_tokens[position + matched]:
+            matched += 1
+        drafted += len(draft)
+        accepted += matched
+        steps += 1
+        position += matched + 1
+    return {
+        "drafted_tokens": drafted,
+        "accepted_tokens": accepted,
+        "acceptance_rate": accepted / drafted if drafted else 0.0,
+        "target_steps": steps,
+        "tokens_per_step": len(target_tokens) / steps if steps else 0.0,
+    }
+
+def time_generation(model, tokenizer, prompt, new_tokens, runs, generation_kwargs):
+    """
+    Times greedy generation of a prompt.
+
+    Args:
+        model: Target model
+        tokenizer: Tokenizer matching model
+        prompt (str): Prompt
+        new_tokens (int): Maximum new tokens
+        runs (int): Timed runs, the median is kept
+        generation_kwargs (dict): Speculative decoding arguments
+
+    Returns:
+        tuple: (median seconds, generated token ids)
+    """
+    inputs = tokenizer(prompt, return_tensors="pt").to(model.device)
+    seconds = []
+    with torch.no_grad():
+        for _ in range(runs):
+            start = time.perf_counter()
+            outputs = model.generate(
+                **inputs,
+                **generation_kwargs,
+                max_new_tokens=new_tokens,
+                do_sample=False,
+                pad_token_id=tokenizer.eos_token_id
+            )
+            seconds.append(time.perf_counter() - start)
+    return statistics.median(seconds), outputs[0, inputs.input_ids.shape[-1]:].tolist()
+
+def benchmark_speculative(target_model_path, draft_model_path=None, scenarios_file=None, new_tokens=128, runs=3, num_tokens=10):
+    """
+    Compares greedy generation with and without speculative decoding on CPU.
+
+    Args:
+        target_model_path (str): Target model path or Hugging Face id
+        draft_model_path (str): Draft model sharing the target tokenizer, or None to only
+            benchmark prompt lookup
+        scenarios_file (str): Scenarios to build prompts from, or None for a single example
+        new_tokens (int): Maximum new tokens per prompt
+        runs (int): Timed runs per prompt and mode
+        num_tokens (int): Tokens drafted per step by prompt lookup
+
+    Returns:
+        dict: Acceptance rate and speedup per mode
+    """
+    torch.manual_seed(0)
+    tokenizer = AutoTokenizer.from_pretrained(target_model_path, trust_remote_code=True)
+    model = AutoModelForCausalLM.from_pretrained(target_model_path, torch_dtype=torch.float32, trust_remote_code=True)
+    model.eval()
+    draft_model = None
+    if draft_model_path:
+        draft_model = AutoModelForCausalLM.from_pretrained(draft_model_path, torch_dtype=torch.float32, trust_remote_code=True)
+        draft_model.eval()
+
+    if scenarios_file:
+        prompts = [build_prompt(scenario["prompt"], "") for scenario in load_scenarios(scenarios_file)]
+    else:
+        prompts = [build_prompt("Create a behavior tree for a tank platoon patrol.", "")]
+
+    drafters = {"prompt_lookup": lambda tokens: prompt_lookup_draft(tokens, num_tokens)}
+    if draft_model is not None:
+        drafters["draft"] = lambda tokens: draft_model_draft(draft_model, tokens)
+
+    # Warm up before timing
+    time_generation(model, tokenizer, prompts[0], 8, 1, {})
+
+    results = {"target_model": target_model_path, "draft_model": draft_model_path, "prompts": len(prompts), "modes": {}}
+    baseline_seconds = 0.0
+    mode_seconds = {mode: 0.0 for mode in drafters}
+    mode_acceptance = {mode: {"drafted_tokens": 0, "accepted_tokens": 0, "target_steps": 0, "generated_tokens": 0} for mode in drafters}
+    identical = {mode: True for mode in drafters}
+
+    for prompt in prompts:
+        prompt_tokens = tokenizer(prompt).input_ids
+        seconds, target_tokens = time_generation(model, tokenizer, prompt, new_tokens, runs, {})
+        baseline_seconds += seconds
+
+        for mode, drafter in drafters.items():
+            seconds, tokens = time_generation(
+                model, tokenizer, prompt, new_tokens, runs,
+                speculative_kwargs(mode, draft_model, num_tokens)
+            )
+            mode_seconds[mode] += seconds
+            identical[mode] = identical[mode] and tokens == target_tokens
+
+            acceptance = measure_acceptance(prompt_tokens, target_tokens, drafter)
+            for key in ("drafted_tokens", "accepted_tokens", "target_steps"):
+                mode_acceptance[mode][key] += acceptance[key]
+            mode_acceptance[mode]["generated_tokens"] += len(target_tokens)
+
+    results["baseline_seconds"] = baseline_seconds
+    for mode in drafters:
+        totals = mode_acceptance[mode]
+        results["modes"][mode] = {
+            "seconds": mode_seconds[mode],
+            "speedup": baseline_seconds / mode_seconds[mode],
+            "acceptance_rate": totals["accepted_tokens"] / totals["drafted_tokens"] if totals["drafted_tokens"] else 0.0,
+            "tokens_per_target_step": totals["generated_tokens"] / totals["target_steps"] if totals["target_steps"] else 0.0,
+            "identical_greedy_output": identical[mode],
+        }
+        log_benchmark(
+            f"speculative {mode}: acceptance {results['modes'][mode]['acceptance_rate']:.2%}, "
+            f"{results['modes'][mode]['tokens_per_target_step']:.2f} tokens/step, "
+            f"speedup {results['modes'][mode]['speedup']:.2f}x over {len(prompts)} prompts"
+        )
+
+    logger.info(json.dumps(results, indent=2))
+    return results
+
+if __name__ == "__main__":
+    load_dotenv()
+    parser = argparse.ArgumentParser(description="Speculative decoding for behavior tree generation")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    benchmark_parser = subparsers.add_parser("benchmark", help="Acceptance rate and speedup on CPU")
+    benchmark_parser.add_argument("target_model")
+    benchmark_parser.add_argument("--draft-model", default=os.getenv('DRAFT_MODEL_PATH'))
+    benchmark_parser.add_argument("--scenarios")
+    benchmark_parser.add_argument("--new-tokens", type=int, default=128)
+    benchmark_parser.add_argument("--runs", type=int, default=3)
+    benchmark_parser.add_argument("--num-tokens", type=int, default=10, help="Tokens drafted per step by prompt lookup")
+
+    args = parser.parse_args()
+    benchmark_speculative(args.target_model, args.draft_model, args.scenarios, args.new_tokens, args.runs, args.num_tokens)
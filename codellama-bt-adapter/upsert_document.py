@@ -1,18 +1,45 @@
-import pdfplumber
-from sentence_transformers import SentenceTransformer
-from pinecone import Pinecone, ServerlessSpec
+import hashlib
+import json
 import os
+from concurrent.futures import ProcessPoolExecutor
 from dotenv import load_dotenv
 
+from embedding_service import embed_texts
+from header_chunker import chunk_header, collect_bases, is_header
+from local_index import LocalVectorIndex, local_index_path
+
 load_dotenv()
 
-# Function to extract text from PDF
-def extract_text_from_pdf(pdf_path):
-    text = ""
+# PDFs with fewer pages than this are extracted in this process, a pool costs more to start
+MIN_PAGES_PER_WORKER = 8
+
+# Chunk ids are keyed on file paths relative to this directory, so files of the same name in
+# different directories (EntityAI/X.h, UnitAI/X.h) never share or delete each other's ids
+SOURCE_ROOT = os.path.dirname(os.path.abspath(__file__))
+
+# Function to extract the text of a range of PDF pages (runs in a worker process)
+def extract_pdf_pages(pdf_path, start, end):
+    # Imported here so that ingesting headers alone does not need pdfplumber
+    import pdfplumber
     with pdfplumber.open(pdf_path) as pdf:
-        for page in pdf.pages:
-            text += page.extract_text()
-    return text
+        return "".join(page.extract_text() or "" for page in pdf.pages[start:end])
+
+# Function to extract text from PDF, splitting the pages over a process pool
+def extract_text_from_pdf(pdf_path, workers=None):
+    import pdfplumber
+    with pdfplumber.open(pdf_path) as pdf:
+        page_count = len(pdf.pages)
+
+    workers = min(workers or os.cpu_count() or 1, page_count // MIN_PAGES_PER_WORKER)
+    if workers <= 1:
+        return extract_pdf_pages(pdf_path, 0, page_count)
+
+    # Contiguous page ranges, joined back in page order
+    step = -(-page_count // workers)
+    starts = list(range(0, page_count, step))
+    with ProcessPoolExecutor(max_workers=workers) as pool:
+        texts = pool.map(extract_pdf_pages, [pdf_path] * len(starts), starts, [start + step for start in starts])
+        return "".join(texts)
 
 # Function to extract text from .h files
 def extract_text_from_header(header_path):
@@ -24,14 +51,14 @@ def extract_text_from_header(header_path):
 def chunk_text(text, chunk_size=500):
     return [text[i:i + chunk_size] for i in range(0, len(text), chunk_size)]
 
-# Function to embed text chunks
+# Function to embed text chunks with the shared model; unchanged chunks come from the cache
 def embed_chunks(chunks, model_name='all-MiniLM-L6-v2'):
-    model = SentenceTransformer(model_name)
-    embeddings = model.encode(chunks)
-    return embeddings
+    return embed_texts(chunks, model_name)
 
 # Function to initialize Pinecone and create an index
 def init_pinecone(api_key, index_name, dimension=384):
+    # Imported here so that local-only ingestion does not need the Pinecone client
+    from pinecone import Pinecone, ServerlessSpec
     pc = Pinecone(api_key=api_key)
     if index_name not in pc.list_indexes():
         pc.create_index(
@@ -45,50 +72,233 @@ def init_pinecone(api_key, index_name, dimension=384):
         )
     return pc.Index(index_name)
 
-# Function to upsert embeddings into Pinecone
-def upsert_embeddings(index, embeddings, chunks, batch_size=100):
+# Function to open the local index, queried by retrieve_context.py without a network round-trip
+def init_local_index(index_name):
+    return LocalVectorIndex(local_index_path(index_name))
+
+# Function to open every index chunks are written to: the local index, and the Pinecone
+# index as well when an API key is configured
+def init_indexes(api_key, index_name):
+    indexes = [init_local_index(index_name)]
+    if api_key:
+        indexes.append(init_pinecone(api_key, index_name))
+    return indexes
+
+# Function to return the text embedded for a chunk: a plain string, or the "embed_text" of a
+# header node chunk (its "text" is too long for the embedding model) or else its "text"
+def chunk_content(chunk):
+    if isinstance(chunk, dict):
+        return chunk.get("embed_text", chunk["text"])
+    return chunk
+
+# Function to return the metadata stored with a chunk: the full text returned as context and
+# the header chunk keys (node, kind, level, handles, source), without the embedded text
+def chunk_metadata(chunk):
+    if isinstance(chunk, dict):
+        return {key: value for key, value in chunk.items() if key != "embed_text"}
+    return {"text": chunk}
+
+# Function to return the SHA-256 of a file's contents
+def file_hash(file_path):
+    digest = hashlib.sha256()
+    with open(file_path, 'rb') as file:
+        for block in iter(lambda: file.read(1 << 20), b""):
+            digest.update(block)
+    return digest.hexdigest()
+
+# Function to return the path of a file relative to SOURCE_ROOT, with forward slashes
+def source_name(file_path):
+    return os.path.relpath(os.path.abspath(file_path), SOURCE_ROOT).replace(os.sep, '/')
+
+# Function to return the stable id of a chunk: the file's relative path and a hash of the
+# chunk text and metadata, so the same chunk keeps its id across runs and files never share ids
+def chunk_id(file_path, chunk):
+    content = json.dumps(chunk, sort_keys=True) if isinstance(chunk, dict) else chunk
+    return f"{source_name(file_path)}-{hashlib.sha256(content.encode('utf-8')).hexdigest()[:16]}"
+
+# Function to return the path of the ingestion manifest of an index: file hash and chunk
+# ids of every ingested file. It lives next to the local index directory, which save() replaces.
+def manifest_path(index_name):
+    return f"{local_index_path(index_name)}.manifest.json"
+
+# Function to load the ingestion manifest, empty before the first run
+def load_manifest(index_name):
+    path = manifest_path(index_name)
+    if not os.path.exists(path):
+        return {}
+    with open(path, 'r', encoding='utf-8') as file:
+        return json.load(file)
+
+# Function to write the ingestion manifest, atomically
+def save_manifest(index_name, manifest):
+    path = manifest_path(index_name)
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(f"{path}.tmp", 'w', encoding='utf-8') as file:
+        json.dump(manifest, file, indent=2, sort_keys=True)
+    os.replace(f"{path}.tmp", path)
+
+# Function to return the ids an index holds: the local index's directly, Pinecone's listed
+# page by page, so vectors written by earlier versions of this script are found as well
+def stored_vector_ids(index):
+    if isinstance(index, LocalVectorIndex):
+        return index.ids()
+    ids = set()
+    for page in index.list():
+        ids.update(page)
+    return ids
+
+# Function to return whether an id is stale: written by the original positional scheme (the
+# chunk number alone), or keyed on an ingested file but no longer one of its chunks
+def is_stale_id(vector_id, sources, current_ids):
+    if vector_id in current_ids:
+        return False
+    return vector_id.isdigit() or vector_id.rsplit('-', 1)[0] in sources
+
+# Function to delete vectors in batches; Pinecone accepts at most 1000 ids per delete
+def delete_ids(index, ids, batch_size=1000):
+    ids = sorted(ids)
+    for i in range(0, len(ids), batch_size):
+        index.delete(ids=ids[i:i + batch_size])
+
+# Function to upsert embeddings into an index (local or Pinecone)
+def upsert_embeddings(index, embeddings, chunks, ids, batch_size=100):
     for i in range(0, len(embeddings), batch_size):
         batch_vectors = []
         for j in range(i, min(i + batch_size, len(embeddings))):
-            batch_vectors.append((str(j), embeddings[j].tolist(), {"text": chunks[j]}))
+            batch_vectors.append((ids[j], embeddings[j].tolist(), chunk_metadata(chunks[j])))
         index.upsert(batch_vectors)
 
+# Main function to ingest files incrementally. Unchanged files are not extracted again,
+# only chunks whose id is new are embedded, and the vectors of chunks that disappeared
+# (edited or deleted files) are deleted. Headers are chunked per state tree node type,
+# other files (PDFs) in fixed-size windows.
+def ingest_files(file_paths, pinecone_api_key, pinecone_index_name, file_type=None):
+    manifest = load_manifest(pinecone_index_name)
+    indexes = init_indexes(pinecone_api_key, pinecone_index_name)
+    # Ids every index really holds, so that a deleted or newly added index is filled in
+    index_ids = [stored_vector_ids(index) for index in indexes]
+    stored_ids = set.intersection(*index_ids)
+
+    file_types = {
+        file_path: file_type or ("pdf" if file_path.lower().endswith(".pdf") else "header")
+        for file_path in file_paths
+    }
+    header_texts = {
+        file_path: extract_text_from_header(file_path)
+        for file_path in file_paths if file_types[file_path] == "header"
+    }
+    # Derived node structs are resolved across all the headers
+    bases = collect_bases(header_texts.values()) if header_texts else {}
+
+    new_ids = []
+    new_chunks = []
+    current_ids = set()
+    removed_ids = set()
+    skipped = 0
+    skipped_files = 0
+    for file_path in file_paths:
+        key = os.path.abspath(file_path)
+        entry = manifest.get(key)
+        prefix = f"{source_name(file_path)}-"
+        if file_path in header_texts:
+            digest = hashlib.sha256(header_texts[file_path].encode('utf-8')).hexdigest()
+        else:
+            digest = file_hash(file_path)
+
+        # Ids of another key scheme (e.g. the file name alone) are re-keyed
+        if (entry and entry["hash"] == digest and stored_ids.issuperset(entry["ids"])
+                and all(vector_id.startswith(prefix) for vector_id in entry["ids"])):
+            skipped += len(entry["ids"])
+            skipped_files += 1
+            current_ids.update(entry["ids"])
+            continue
+
+        if file_path in header_texts:
+            chunks = chunk_header(header_texts[file_path], os.path.basename(file_path), bases)
+        else:
+            chunks = chunk_text(extract_text_from_pdf(file_path))
+        # Identical chunks share an id and are stored once
+        file_chunks = {chunk_id(file_path, chunk): chunk for chunk in chunks}
+
+        if entry:
+            previous_ids = set(entry["ids"])
+        else:
+            # Vectors stored under this file's path whose manifest entry was lost
+            previous_ids = {vector_id for vector_id in stored_ids if vector_id.startswith(prefix)}
+
+        for vector_id, chunk in file_chunks.items():
+            if vector_id in previous_ids and vector_id in stored_ids:
+                skipped += 1
+            else:
+                new_ids.append(vector_id)
+                new_chunks.append(chunk)
+        current_ids.update(file_chunks)
+        removed_ids |= previous_ids - file_chunks.keys()
+        manifest[key] = {"hash": digest, "ids": list(file_chunks)}
+
+    # Files ingested before that no longer exist
+    for key in list(manifest):
+        if not os.path.exists(key):
+            removed_ids |= set(manifest.pop(key)["ids"])
+    removed_ids -= current_ids
+
+    # Stale ids are looked up in each index as well, not only in the manifest: Pinecone may
+    # hold positional ids, ids keyed on the file name alone or chunks the local index never had
+    sources = {source_name(file_path) for file_path in file_paths}
+    sources |= {os.path.basename(file_path) for file_path in file_paths}
+    deleted_ids = set()
+
+    # Nothing new when every file is unchanged: the embedding model is not even loaded
+    embeddings = embed_chunks([chunk_content(chunk) for chunk in new_chunks]) if new_chunks else []
+    for index, ids in zip(indexes, index_ids):
+        index_removed_ids = (removed_ids & ids) | {
+            vector_id for vector_id in ids if is_stale_id(vector_id, sources, current_ids)
+        }
+        upsert_embeddings(index, embeddings, new_chunks, new_ids)
+        delete_ids(index, index_removed_ids)
+        deleted_ids |= index_removed_ids
+        if isinstance(index, LocalVectorIndex):
+            index.save()
+    save_manifest(pinecone_index_name, manifest)
+
+    stats = {
+        "files": len(file_paths),
+        "files_skipped": skipped_files,
+        "chunks_embedded": len(new_chunks),
+        "chunks_skipped": skipped,
+        "chunks_deleted": len(deleted_ids),
+    }
+    print(
+        f"Embedded {stats['chunks_embedded']} chunks, skipped {stats['chunks_skipped']} unchanged "
+        f"({stats['files_skipped']} of {stats['files']} files unchanged) and deleted "
+        f"{stats['chunks_deleted']} stale chunks in {len(indexes)} index(es)."
+    )
+    return stats
 
 # Main function to handle the entire process
 def add_pdf_to_pinecone(pdf_path, pinecone_api_key, pinecone_index_name):
-    extracted_text = extract_text_from_pdf(pdf_path)
-    chunks = chunk_text(extracted_text)
-    embeddings = embed_chunks(chunks)
-    index = init_pinecone(pinecone_api_key, pinecone_index_name)
-    upsert_embeddings(index, embeddings, chunks)
-    print(f"Successfully added {len(chunks)} chunks from the PDF to Pinecone.")
+    return ingest_files([pdf_path], pinecone_api_key, pinecone_index_name, file_type="pdf")
 
 # Main function to add header files to pinecone
 def add_file_to_pinecone(file_path, pinecone_api_key, pinecone_index_name, file_type="header"):
-    if file_type == "header":
-        extracted_text = extract_text_from_header(file_path)
-    else:
-        extracted_text = extract_text_from_pdf(file_path)
-        
-    chunks = chunk_text(extracted_text)
-    embeddings = embed_chunks(chunks)
-    index = init_pinecone(pinecone_api_key, pinecone_index_name)
-    upsert_embeddings(index, embeddings, chunks)
-    print(f"Successfully added {len(chunks)} chunks from {file_path} to Pinecone.")
-
-
-# Define your variables
-pdf_path = 'tank.pdf'  # Path to your PDF file
-pinecone_api_key = os.getenv('PINECONE_API_KEY')  # Your Pinecone API key
-pinecone_index_name = 'pdf-rag-index'  # Name of your Pinecone index
-
-# Run the function to add the PDF to Pinecone
-add_pdf_to_pinecone(pdf_path, pinecone_api_key, pinecone_index_name)
-
-
-# (Example) Load all header files from EntityAI module
-# Load all header files
-header_dir = "header_files/EntityAI"
-for filename in os.listdir(header_dir):
-    file_path = os.path.join(header_dir, filename)
-    add_file_to_pinecone(file_path, pinecone_api_key, pinecone_index_name, file_type="header")
\ No newline at end of file
+    return ingest_files([file_path], pinecone_api_key, pinecone_index_name, file_type)
+
+# Main function to add many files at once: all new chunks are embedded in one batched call
+# and every index is written once
+def add_files_to_indexes(file_paths, pinecone_api_key, pinecone_index_name, file_type="header"):
+    return ingest_files(file_paths, pinecone_api_key, pinecone_index_name, file_type)
+
+
+# Guarded so that the PDF extraction worker processes can import this module
+if __name__ == "__main__":
+    # Define your variables
+    pdf_path = 'tank.pdf'  # Path to your PDF file
+    pinecone_api_key = os.getenv('PINECONE_API_KEY')  # Your Pinecone API key
+    pinecone_index_name = 'pdf-rag-index'  # Name of your Pinecone index
+
+    # (Example) Load all header files from EntityAI module
+    header_dir = "header_files/EntityAI"
+    header_paths = [os.path.join(header_dir, filename) for filename in sorted(os.listdir(header_dir)) if is_header(filename)]
+
+    # Run the ingestion of the PDF and the headers; unchanged files are skipped
+    ingest_files([pdf_path] + header_paths, pinecone_api_key, pinecone_index_name)
@@ -0,0 +1,596 @@
+# xml_grammar.py
+"""
+Grammar constrained decoding of behavior tree XML.
+
+The grammar accepts trees of the form
+
+    <root main_tree_to_execute="MainTree">
+      <BehaviorTree ID="MainTree">
+        <Sequence name="...">
+          <Condition ID="EnemyContactCondition"/>
+          <Action ID="EngageTargetTask" name="..."/>
+        </Sequence>
+      </BehaviorTree>
+    </root>
+
+Control nodes hold one or more children. Leaf IDs are restricted to the state tree tasks
+(Action), conditions (Condition) and evaluators (Evaluator) declared in header_files/EntityAI
+and header_files/UnitAI. During generation BehaviorTreeLogitsProcessor masks every token that
+would leave the grammar, so each generated tree parses and only references real node types.
+
+Usage:
+    python3 xml_grammar.py             # lists the leaf types found in header_files
+"""
+import logging
+import os
+import re
+
+import torch
+from transformers import LogitsProcessor
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger(__name__)
+
+HEADER_DIRS = [
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "header_files", "EntityAI"),
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "header_files", "UnitAI"),
+]
+
+# Leaf element of each state tree node base class
+LEAF_BASES = {
+    "FMilVerseStateTreeTask": "Action",
+    "FMilVersePersistentStateTreeTask": "Action",
+    "FMilVerseStateTreeCondition": "Condition",
+    "FMilVerseStateTreeEvaluator": "Evaluator",
+}
+
+CONTROL_NODES = [
+    "Sequence",
+    "Fallback",
+    "ReactiveSequence",
+    "ReactiveFallback",
+    "Parallel",
+]
+
+ROOT_OPEN = '<root main_tree_to_execute="MainTree">'
+TREE_OPEN = '<BehaviorTree ID="MainTree">'
+TREE_CLOSE = '</BehaviorTree>'
+ROOT_CLOSE = '</root>'
+
+WHITESPACE = " \n\t"
+# Characters allowed in name attributes
+TEXT_CHARS = set(
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 _-.,:;()/'"
+)
+
+STRUCT_PATTERN = re.compile(r"^(?:struct|class)\s+(?:\w+_API\s+)?F(\w+)\s*:\s*public\s+(\w+)", re.MULTILINE)
+
+def load_leaf_types(header_dirs=None):
+    """
+    Collects the state tree tasks, conditions and evaluators declared in the headers.
+
+    Structs deriving from another leaf struct (e.g. FAviationMoveTask : FMoveTask) take the
+    kind of their base.
+
+    Args:
+        header_dirs (list): Directories to scan, header_files/EntityAI and UnitAI by default
+
+    Returns:
+        dict: Leaf element ("Action", "Condition", "Evaluator") -> sorted type names
+    """
+    bases = {}
+    for header_dir in header_dirs or HEADER_DIRS:
+        for filename in sorted(os.listdir(header_dir)):
+            if not filename.endswith(".h"):
+                continue
+            with open(os.path.join(header_dir, filename), 'r', encoding='utf-8', errors='ignore') as f:
+                for name, base in STRUCT_PATTERN.findall(f.read()):
+                    bases[name] = base
+
+    def leaf_kind(name, seen=()):
+        base = bases.get(name)
+        if base in LEAF_BASES:
+            return LEAF_BASES[base]
+        if base and base.startswith("F") and base[1:] not in seen:
+            return leaf_kind(base[1:], seen + (name,))
+        return None
+
+    leaf_types = {kind: set() for kind in set(LEAF_BASES.values())}
+    for name in bases:
+        kind = leaf_kind(name)
+        if kind:
+            leaf_types[kind].add(name)
+    return {kind: sorted(names) for kind, names in leaf_types.items()}
+
+def build_trie(alternatives):
+    """
+    Builds a character trie of literal alternatives.
+
+    Args:
+        alternatives (dict): Literal -> action taken once it has been matched
+
+    Returns:
+        dict: Nested {char: node} dicts; complete literals store their action under None
+    """
+    root = {}
+    for literal, action in alternatives.items():
+        node = root
+        for char in literal:
+            node = node.setdefault(char, {})
+        node[None] = action
+    return root
+
+class BehaviorTreeGrammar:
+    """
+    Character level pushdown automaton of the behavior tree XML.
+
+    States are immutable tuples (phase, trie node, stack, counter), so they can be shared
+    while exploring many candidate tokens. phase is either a literal phase matched against
+    a trie of alternatives, or "text" for a name attribute value. stack holds the open
+    control nodes and counter the whitespace or text characters consumed so far.
+
+    Args:
+        leaf_types (dict): Leaf element -> allowed IDs, load_leaf_types() by default
+        max_depth (int): Maximum nesting of control nodes
+        max_text (int): Maximum length of a name attribute
+        indent_width (int): Widest indentation per nesting level. A run of whitespace between
+            elements may hold a line break and the indentation of the current depth (root,
+            BehaviorTree and the open control nodes), so deep trees keep their layout
+    """
+
+    END = "end"
+
+    def __init__(self, leaf_types=None, max_depth=8, max_text=48, indent_width=4):
+        self.leaf_types = leaf_types or load_leaf_types()
+        self.max_depth = max_depth
+        self.max_text = max_text
+        self.indent_width = indent_width
+
+        node_open = {}
+        leaf_open = {}
+        for control in CONTROL_NODES:
+            node_open[f'<{control}>'] = ("push", control, "node")
+            node_open[f'<{control} name="'] = ("push", control, "text", "control_close")
+        for kind, names in self.leaf_types.items():
+            if names:
+                leaf_open[f'<{kind} ID="'] = ("goto", f"leaf_id:{kind}")
+
+        self.tries = {
+            "root_open": build_trie({ROOT_OPEN: ("goto", "tree_open")}),
+            "tree_open": build_trie({TREE_OPEN: ("goto", "node")}),
+            "tree_close": build_trie({TREE_CLOSE: ("goto", "root_close")}),
+            "root_close": build_trie({ROOT_CLOSE: ("goto", self.END)}),
+            "control_close": build_trie({'>': ("goto", "node")}),
+            "leaf_end": build_trie({'/>': ("done",), ' name="': ("text", "leaf_close")}),
+            "leaf_close": build_trie({'/>': ("done",)}),
+            "node": build_trie({**node_open, **leaf_open}),
+            "node_leaf": build_trie(leaf_open),
+        }
+        for kind, names in self.leaf_types.items():
+            self.tries[f"leaf_id:{kind}"] = build_trie({f'{name}"': ("goto", "leaf_end") for name in names})
+        self.after_child_tries = {}
+        self.after_child_leaf_tries = {}
+        for control in CONTROL_NODES:
+            close = {f'</{control}>': ("pop",)}
+            self.after_child_tries[control] = build_trie({**node_open, **leaf_open, **close})
+            self.after_child_leaf_tries[control] = build_trie({**leaf_open, **close})
+
+        # Phases where whitespace may precede the literal
+        self.whitespace_phases = {"root_open", "tree_open", "tree_close", "root_close", "node", "after_child"}
+
+        self.min_name_length = {
+            f"leaf_id:{kind}": min(len(name) for name in names)
+            for kind, names in self.leaf_types.items() if names
+        }
+        self.min_leaf_length = min(
+            len(f'<{kind} ID="') + length + 3
+            for kind, length in ((phase.split(":")[1], length) for phase, length in self.min_name_length.items())
+        )
+        self.completion_cache = {}
+
+    def initial_state(self):
+        """Returns the state before the first character of the tree."""
+        return self.literal_state("root_open", ())
+
+    def trie_for(self, phase, stack):
+        """Returns the trie of alternatives of a literal phase."""
+        if phase == "node":
+            return self.tries["node" if len(stack) < self.max_depth else "node_leaf"]
+        if phase == "after_child":
+            tries = self.after_child_tries if len(stack) < self.max_depth else self.after_child_leaf_tries
+            return tries[stack[-1]]
+        return self.tries[phase]
+
+    def max_whitespace(self, stack):
+        """Returns the longest run of whitespace allowed before a literal at a nesting depth."""
+        # A line break (possibly blank lines) and one indentation level for root, BehaviorTree
+        # and each open control node
+        return 2 + self.indent_width * (len(stack) + 2)
+
+    def literal_state(self, phase, stack):
+        """Returns the state at the start of a literal phase."""
+        if phase == self.END:
+            return (self.END, None, stack, 0)
+        return (phase, self.trie_for(phase, stack), stack, 0)
+
+    def after_node(self, stack):
+        """Returns the state after a complete child node."""
+        return self.literal_state("after_child" if stack else "tree_close", stack)
+
+    def apply(self, action, stack):
+        """Returns the state after a literal with the given action was matched."""
+        kind = action[0]
+        if kind == "goto":
+            return self.literal_state(action[1], stack)
+        if kind == "push":
+            stack = stack + (action[1],)
+            if action[2] == "text":
+                return ("text", action[3], stack, 0)
+            return self.literal_state(action[2], stack)
+        if kind == "text":
+            return ("text", action[1], stack, 0)
+        if kind == "pop":
+            return self.after_node(stack[:-1])
+        return self.after_node(stack)
+
+    def advance(self, state, char):
+        """
+        Consumes one character.
+
+        Args:
+            state (tuple): Current state
+            char (str): Next character
+
+        Returns:
+            tuple: Next state, or None if the character is not allowed
+        """
+        phase, node, stack, counter = state
+        if phase == self.END:
+            return None
+
+        if phase == "text":
+            if char == '"':
+                return self.literal_state(node, stack)
+            if char in TEXT_CHARS and counter < self.max_text:
+                return (phase, node, stack, counter + 1)
+            return None
+
+        child = node.get(char)
+        if child is not None:
+            action = child.get(None)
+            # Alternatives are prefix free, so a complete literal has no longer continuation
+            if action is not None:
+                return self.apply(action, stack)
+            return (phase, child, stack, 0)
+
+        # Whitespace is only allowed before the first character of a literal
+        if (char in WHITESPACE and phase in self.whitespace_phases
+                and node is self.trie_for(phase, stack) and counter < self.max_whitespace(stack)):
+            return (phase, node, stack, counter + 1)
+        return None
+
+    def state_key(self, state):
+        """Returns a hashable key of a state (trie nodes are identified by object id)."""
+        phase, node, stack, counter = state
+        return (phase, id(node) if isinstance(node, dict) else node, stack, counter)
+
+    def closing_length(self, stack):
+        """Returns the length of the closing tags of the open control nodes, tree and root."""
+        return sum(len(f'</{control}>') for control in stack) + len(TREE_CLOSE) + len(ROOT_CLOSE)
+
+    def phase_completion_length(self, phase, stack):
+        """Returns the shortest completion, in characters, from the start of a phase."""
+        leaf = self.min_leaf_length
+        if phase == self.END:
+            return 0
+        if phase == "root_open":
+            return len(ROOT_OPEN) + len(TREE_OPEN) + leaf + self.closing_length(stack)
+        if phase == "tree_open":
+            return len(TREE_OPEN) + leaf + self.closing_length(stack)
+        if phase == "node":
+            return leaf + self.closing_length(stack)
+        if phase == "control_close":
+            return 1 + leaf + self.closing_length(stack)
+        if phase.startswith("leaf_id:"):
+            return self.min_name_length[phase] + 3 + self.closing_length(stack)
+        if phase in ("leaf_end", "leaf_close"):
+            return 2 + self.closing_length(stack)
+        if phase == "tree_close":
+            return len(TREE_CLOSE) + len(ROOT_CLOSE)
+        if phase == "root_close":
+            return len(ROOT_CLOSE)
+        # after_child: close the current control node and everything above it
+        return self.closing_length(stack)
+
+    def completion_length(self, state):
+        """
+        Returns the number of characters of the shortest text completing the tree from a state.
+
+        Args:
+            state (tuple): Grammar state
+
+        Returns:
+            int: Shortest completion length
+        """
+        phase, node, stack, _ = state
+        if phase == "text":
+            return 1 + self.phase_completion_length(node, stack)
+        if phase == self.END or node is self.trie_for(phase, stack):
+            return self.phase_completion_length(phase, stack)
+
+        key = (id(node), stack)
+        length = self.completion_cache.get(key)
+        if length is None:
+            # Inside a literal: the cheapest complete alternative below this trie node
+            length = None
+            pending = [(node, 0)]
+            while pending:
+                trie_node, depth = pending.pop()
+                for char, child in trie_node.items():
+                    if char is None:
+                        candidate = depth + self.completion_length(self.apply(child, stack))
+                        length = candidate if length is None else min(length, candidate)
+                    else:
+                        pending.append((child, depth + 1))
+            self.completion_cache[key] = length
+        return length
+
+    def text_budget(self, state):
+        """Returns the number of characters a name attribute may still take, or None outside one."""
+        return self.max_text - state[3] if state[0] == "text" else None
+
+    def is_complete(self, state):
+        """Returns True once the closing root tag has been generated."""
+        return state[0] == self.END
+
+    def accepts(self, text):
+        """Returns True if text is a complete tree of the grammar."""
+        state = self.initial_state()
+        for char in text:
+            state = self.advance(state, char)
+            if state is None:
+                return False
+        return self.is_complete(state)
+
+def token_strings(tokenizer):
+    """
+    Returns the text of every token of a tokenizer.
+
+    Args:
+        tokenizer: Hugging Face tokenizer
+
+    Returns:
+        dict: Token id -> text, without special tokens and tokens that are not plain ASCII
+    """
+    special_ids = set(tokenizer.all_special_ids)
+    strings = {}
+    for token, token_id in tokenizer.get_vocab().items():
+        if token_id in special_ids:
+            continue
+        byte_token = re.fullmatch(r"<0x([0-9A-Fa-f]{2})>", token)
+        if byte_token:
+            value = int(byte_token.group(1), 16)
+            text = chr(value) if value < 0x80 else ""
+        elif "▁" in token:
+            # SentencePiece marks spaces with U+2581
+            text = token.replace("▁", " ")
+        else:
+            text = tokenizer.convert_tokens_to_string([token])
+        if text and text.isascii():
+            strings[token_id] = text
+    return strings
+
+class TokenTrie:
+    """
+    Character trie over the vocabulary, used to find every token allowed in a grammar state
+    without testing the whole vocabulary token by token.
+
+    Most of the vocabulary is plain text, which is allowed anywhere inside a name attribute.
+    Those tokens are kept in per-length lists instead of being walked, and only the tokens
+    containing other characters go into the trie walked for text states.
+
+    Args:
+        strings (dict): Token id -> text
+    """
+
+    def __init__(self, strings):
+        self.root = {}
+        self.markup_root = {}
+        self.text_tokens = {}
+        for token_id, text in strings.items():
+            self.insert(self.root, text, token_id)
+            if set(text) <= TEXT_CHARS:
+                self.text_tokens.setdefault(len(text), []).append(token_id)
+            else:
+                self.insert(self.markup_root, text, token_id)
+
+    @staticmethod
+    def insert(root, text, token_id):
+        node = root
+        for char in text:
+            node = node.setdefault(char, {})
+        node.setdefault(None, []).append(token_id)
+
+    def allowed_tokens(self, grammar, state):
+        """
+        Returns the ids of every token whose text the grammar accepts from a state.
+
+        Args:
+            grammar (BehaviorTreeGrammar): Grammar
+            state (tuple): Grammar state
+
+        Returns:
+            list: Allowed token ids
+        """
+        allowed = []
+        root = self.root
+        text_budget = grammar.text_budget(state)
+        if text_budget is not None:
+            for length, token_ids in self.text_tokens.items():
+                if length <= text_budget:
+                    allowed.extend(token_ids)
+            root = self.markup_root
+
+        pending = [(root, state)]
+        while pending:
+            node, grammar_state = pending.pop()
+            for char, child in node.items():
+                if char is None:
+                    continue
+                next_state = grammar.advance(grammar_state, char)
+                if next_state is None:
+                    continue
+                if None in child:
+                    allowed.extend(child[None])
+                pending.append((child, next_state))
+        return allowed
+
+class BehaviorTreeLogitsProcessor(LogitsProcessor):
+    """
+    Masks the tokens that would leave the behavior tree grammar.
+
+    Each batch row is tracked separately. The state of a row is derived from the tokens it
+    generated since the prompt, keeping the states of the longest prefix seen before, so the
+    processor may also score draft positions that are later rejected (speculative decoding).
+    Call prepare() before every generate call. Rows that completed their tree may only emit
+    the end of sequence token. Allowed token masks are cached per grammar state, which
+    repeat heavily between scenarios (e.g. inside leaf IDs and closing tags).
+
+    With max_new_tokens set, tokens after which the tree could no longer be closed within
+    the remaining budget are masked as well, so generation never stops inside a tree. This
+    counts one token per character of the shortest completion, which holds as long as the
+    vocabulary has a token for every single character of the grammar (true of byte
+    fallback tokenizers such as CodeLlama's). A tree closed this way is valid but may be
+    shorter than the model intended, so after each generate call budget_forced[row] tells
+    whether the budget masked any token the grammar allowed in that row.
+
+    Args:
+        grammar (BehaviorTreeGrammar): Grammar to enforce
+        tokenizer: Tokenizer matching the model
+        max_new_tokens (int): Token budget of the generate calls, or None for no budget
+        cache_size (int): Maximum number of cached masks
+    """
+
+    def __init__(self, grammar, tokenizer, max_new_tokens=None, cache_size=50000):
+        self.grammar = grammar
+        self.tokenizer = tokenizer
+        self.strings = token_strings(tokenizer)
+        self.trie = TokenTrie(self.strings)
+        self.max_token_length = max(len(text) for text in self.strings.values())
+        self.eos_token_id = tokenizer.eos_token_id
+        self.max_new_tokens = max_new_tokens
+        self.cache_size = cache_size
+        self.masks = {}
+        self.reset()
+
+    def reset(self):
+        """Forgets the rows of the previous generate call."""
+        self.prompt_length = None
+        self.histories = None
+        self.budget_forced = []
+
+    def prepare(self, max_new_tokens=None):
+        """Resets the processor for a generate call with the given token budget."""
+        self.reset()
+        self.max_new_tokens = max_new_tokens
+
+    def advance_token(self, state, token_id):
+        """Returns the grammar state after a generated token."""
+        if state is None or token_id == self.eos_token_id:
+            return state
+        for char in self.strings.get(token_id, ""):
+            state = self.grammar.advance(state, char)
+            if state is None:
+                return None
+        return state
+
+    def row_state(self, history, tokens):
+        """
+        Returns the grammar state after the generated tokens of a row.
+
+        Args:
+            history (list): (token id, state) pairs of the previous call of the row, updated
+            tokens (list): Token ids generated by the row so far
+
+        Returns:
+            tuple: Grammar state, or None if the tokens left the grammar
+        """
+        shared = 0
+        while shared < min(len(history), len(tokens)) and history[shared][0] == tokens[shared]:
+            shared += 1
+        del history[shared:]
+
+        state = history[-1][1] if history else self.grammar.initial_state()
+        for token_id in tokens[shared:]:
+            state = self.advance_token(state, token_id)
+            history.append((token_id, state))
+        return state
+
+    def allowed_mask(self, state, vocab_size, device, remaining=None):
+        """
+        Returns the additive mask of a grammar state (0 allowed, -inf masked).
+
+        Args:
+            state (tuple): Grammar state of the row
+            vocab_size (int): Width of the scores
+            device: Device of the scores
+            remaining (int): Tokens left in the budget including this one, or None
+
+        Returns:
+            tuple: (mask, True if the budget masked tokens the grammar allows)
+        """
+        # The budget only matters once the longest token could overrun it
+        if remaining is not None and remaining > self.grammar.completion_length(state) + self.max_token_length:
+            remaining = None
+
+        key = (self.grammar.state_key(state), remaining, vocab_size, str(device))
+        entry = self.masks.get(key)
+        if entry is None:
+            forced = False
+            if self.grammar.is_complete(state):
+                allowed = [self.eos_token_id]
+            else:
+                allowed = self.trie.allowed_tokens(self.grammar, state)
+                if remaining is not None:
+                    within_budget = [
+                        token_id for token_id in allowed
+                        if self.grammar.completion_length(self.advance_token(state, token_id)) <= remaining - 1
+                    ]
+                    forced = len(within_budget) < len(allowed)
+                    allowed = within_budget
+            mask = torch.full((vocab_size,), float("-inf"), device=device)
+            mask[torch.tensor([i for i in allowed if i < vocab_size], dtype=torch.long, device=device)] = 0
+            if len(self.masks) >= self.cache_size:
+                self.masks.clear()
+            entry = (mask, forced)
+            self.masks[key] = entry
+        return entry
+
+    def __call__(self, input_ids, scores):
+        # The first call after prepare() sees the prompt alone
+        if self.histories is None or input_ids.shape[0] != len(self.histories):
+            self.prompt_length = input_ids.shape[-1]
+            self.histories = [[] for _ in range(input_ids.shape[0])]
+            self.budget_forced = [False] * input_ids.shape[0]
+
+        generated = input_ids[:, self.prompt_length:].tolist()
+        remaining = self.max_new_tokens - len(generated[0]) if self.max_new_tokens else None
+        for row, tokens in enumerate(generated):
+            state = self.row_state(self.histories[row], tokens)
+            if state is None:
+                # Unreachable while the mask is applied, left unconstrained rather than stuck
+                continue
+            mask, forced = self.allowed_mask(state, scores.shape[-1], scores.device, remaining)
+            self.budget_forced[row] = self.budget_forced[row] or forced
+            scores[row] = scores[row] + mask
+        return scores
+
+    def was_budget_forced(self, row=0):
+        """Returns True if the token budget cut the tree of a row short in the last generate call."""
+        return row < len(self.budget_forced) and self.budget_forced[row]
+
+if __name__ == "__main__":
+    for kind, names in sorted(load_leaf_types().items()):
+        print(f"{kind} ({len(names)}):")
+        for name in names:
+            print(f"- {name}")
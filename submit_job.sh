@@ -83,7 +83,7 @@ submit_job() {
     # Copy the scenarios file
     $SCP_CMD "$SCENARIOS_FILE" ${REMOTE_USER}@${REMOTE_HOST}:${REMOTE_DIR}/
     # Copy Python scripts if they exist locally
-    for script in demo_ssh.py retrieve_context.py; do
+    for script in demo_ssh.py retrieve_context.py model_client.py; do
         if [ -f "$script" ]; then
             $SCP_CMD "$script" ${REMOTE_USER}@${REMOTE_HOST}:${REMOTE_DIR}/codellama-bt-adapter/
         fi